@@ -0,0 +1,227 @@
+#ifndef AGGREGATETREE_H
+#define AGGREGATETREE_H
+//--------------------------------------------------------------------
+// An avl map that keeps a monoid aggregate of its values per subtree
+//--------------------------------------------------------------------
+#include <limits>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// MONOIDS
+	// a monoid names its value_type and supplies identity() and an
+	// associative combine(a, b); combine need not be commutative, values
+	// are always combined in key order
+	//--------------------------------------------------------------------
+	template <class V>
+	struct sumOf
+	{
+		typedef V value_type;
+		static V identity() {return V();}
+		static V combine(const V& a, const V& b) {return a + b;}
+	};
+
+	template <class V>
+	struct minOf
+	{
+		typedef V value_type;
+		static V identity() {return numeric_limits<V>::max();}
+		static V combine(const V& a, const V& b) {return (b < a) ? b : a;}
+	};
+
+	template <class V>
+	struct maxOf
+	{
+		typedef V value_type;
+		static V identity() {return numeric_limits<V>::lowest();}
+		static V combine(const V& a, const V& b) {return (a < b) ? b : a;}
+	};
+
+	//--------------------------------------------------------------------
+	// AGGREGATE ENTRY
+	// a key, its value, and the combined values of the subtree the entry
+	// heads (kept by augment()).  Ordered by key alone.
+	// REQUIRES Type K have < & == defined
+	//--------------------------------------------------------------------
+	template <class K, class Monoid>
+	struct aggregateEntry
+	{
+		typedef typename Monoid::value_type value_type;
+
+		aggregateEntry(K k = K(), value_type v = Monoid::identity())
+			: key(k), value(v), total(v) {}
+		bool operator<(const aggregateEntry<K, Monoid>& e) const
+			{return key < e.key;}
+		bool operator==(const aggregateEntry<K, Monoid>& e) const
+			{return key == e.key;}
+
+		K key;
+		value_type value;
+		value_type total;
+	};
+
+	//--------------------------------------------------------------------
+	// recomputes total from the children; called by node<T>::update()
+	//--------------------------------------------------------------------
+	template <class K, class Monoid>
+	inline void augment(aggregateEntry<K, Monoid>& d,
+		const node<aggregateEntry<K, Monoid>>* left,
+		const node<aggregateEntry<K, Monoid>>* right)
+	{
+		d.total = (left != nullptr)
+			? Monoid::combine(left->value().total, d.value) : d.value;
+		if(right != nullptr)
+			d.total = Monoid::combine(d.total, right->value().total);
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for aggregateEntry<K, Monoid>
+	//--------------------------------------------------------------------
+	template <class K, class Monoid>
+	ostream& operator<<(ostream& out, const aggregateEntry<K, Monoid>& e)
+	{
+		out << e.key << ':' << e.value;
+		return out;
+	}
+
+	//--------------------------------------------------------------------
+	// Aggregate Tree
+	// Class:		aggregateTree<K, Monoid>
+	//				: public avl<aggregateEntry<K, Monoid>>
+	//				REQUIRES Type K be default constructible & have
+	//				< & == defined; Monoid as described above
+	//
+	// File:		aggregateTree.h
+	// Title:		aggregateTree template Class; inherits from avl<T>
+	// Description: Maps unique keys to values and keeps, in every node,
+	//				the Monoid combination of all values in its subtree.
+	//				The totals are refreshed by node<T>::update(), so they
+	//				follow every insert, erase and rotation, and
+	//				aggregate(lo, hi) answers a key-range query by
+	//				combining O(log n) subtree totals.  Lazy erase is not
+	//				available: a tombstone's value would stay in the
+	//				totals above it.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class aggregateTree<K, Monoid>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			aggregateTree() -- default constructor
+	//			bool insert(const K& k, const value_type& v)
+	//				-- adds k with value v; false if k is already present
+	//			void assign(const K& k, const value_type& v)
+	//				-- sets the value of k, adding k if needed
+	//			bool erase(const K& k) -- removes k
+	//			bool lookup(const K& k, value_type& v) const
+	//				-- copies the value of k into v if k is present
+	//			value_type total() const -- aggregate of every value
+	//
+	//     non-inline:
+	//			value_type aggregate(const K& lo, const K& hi) const
+	//				-- aggregate of the values of keys in [lo, hi]
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class K, class Monoid>
+	class aggregateTree : public avl<aggregateEntry<K, Monoid>>
+	{
+	public:
+		typedef aggregateEntry<K, Monoid> entry;
+		typedef typename Monoid::value_type value_type;
+
+		aggregateTree() : avl<entry>() {}
+
+		bool insert(const K& k, const value_type& v)
+			{return avl<entry>::insert(entry(k, v));}
+		void assign(const K& k, const value_type& v)
+			{avl<entry>::erase(entry(k)); avl<entry>::insert(entry(k, v));}
+		bool erase(const K& k) {return avl<entry>::erase(entry(k));}
+		bool lookup(const K& k, value_type& v) const
+		{
+			const node<entry>* np = avl<entry>::find(entry(k));
+			if(np == nullptr)
+				return false;
+			v = np->value().value;
+			return true;
+		}
+		value_type total() const
+			{return root ? root->value().total : Monoid::identity();}
+		value_type aggregate(const K& lo, const K& hi) const;
+
+	protected:
+		using avl<entry>::root;
+
+	private:   // tombstones would keep their values in the totals
+		using avl<entry>::setLazyErase;
+	};
+
+	//--------------------------------------------------------------------
+	// combines, in key order, the values of every key in [lo, hi]
+	// descends to the node where the bounds split, then down each side
+	// taking whole subtree totals that lie inside the range
+	//--------------------------------------------------------------------
+	template <class K, class Monoid>
+	typename Monoid::value_type aggregateTree<K, Monoid>::aggregate(
+		const K& lo, const K& hi) const
+	{
+		const node<entry>* split = root;
+		while(split != nullptr)
+		{
+			if(split->value().key < lo)
+				split = split->right;
+			else if(hi < split->value().key)
+				split = split->left;
+			else
+				break;
+		}
+		if(split == nullptr)
+			return Monoid::identity();
+
+		value_type below = Monoid::identity();   // keys >= lo, left side
+		for(const node<entry>* np = split->left; np != nullptr; )
+		{
+			if(np->value().key < lo)
+				np = np->right;
+			else
+			{
+				value_type part = np->value().value;
+				if(np->right != nullptr)
+					part = Monoid::combine(part, np->right->value().total);
+				below = Monoid::combine(part, below);
+				np = np->left;
+			}
+		}
+		value_type above = Monoid::identity();   // keys <= hi, right side
+		for(const node<entry>* np = split->right; np != nullptr; )
+		{
+			if(hi < np->value().key)
+				np = np->left;
+			else
+			{
+				value_type part = np->value().value;
+				if(np->left != nullptr)
+					part = Monoid::combine(np->left->value().total, part);
+				above = Monoid::combine(above, part);
+				np = np->right;
+			}
+		}
+		return Monoid::combine(Monoid::combine(below, split->value().value),
+			above);
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -6,16 +6,38 @@
 // by Paul Bladek
 // May, 2008
 //--------------------------------------------------------------------
+#include <future>
+#include <thread>
 #include "bst.h"
 using namespace std;
 
 namespace AW_BST
 {
+	const size_t SPLIT_GRAIN = 4096;  // smaller set operations stay on one thread
+
+	//--------------------------------------------------------------------
+	// BALANCING POLICIES
+	// a policy names the largest height difference the tree allows
+	// between the two subtrees of any node.  heightBalance<1> is a
+	// strict avl tree.  A looser policy rotates less on insert and erase
+	// for a taller tree: slack 2 keeps the height under 1.82 log2(n),
+	// inside the 2 log2(n) a red-black tree guarantees, and slack 3 under
+	// 2.15 log2(n).
+	//--------------------------------------------------------------------
+	template<int Slack>
+	struct heightBalance
+	{
+		static const int slack = Slack;
+	};
+	typedef heightBalance<1> avlBalance;
+	typedef heightBalance<2> relaxedBalance;
+
 	//--------------------------------------------------------------------
 	// AVL Tree
-	// Class:		avl<T>: public bst<T>
+	// Class:		avl<T, Balance>: public bst<T>
 	//				REQUIRES Type T be able convert from int & have 
-	//				< & == defined
+	//				< & == defined; Balance a balancing policy, avlBalance
+	//				by default
 	//
 	// File:		avl.h
 	// Title:		avl template Class; inherits from bst<T>
@@ -31,26 +53,73 @@ namespace AW_BST
 	//				Software: OS: Windows 10 
 	//				Compiles under Microsoft Visual C++ 2015
 	// 
-	// class avl<T>:
+	// class avl<T, Balance>:
 	//
 	//   Methods:
 	// 
 	//     inline: 
-	//			avl() -- default constructor
-	//			avl(const avl<T>& t) -- copy constructor (deep copy)
-	//			avl<T>& operator+=(const T d) -- adds an element to the tree
-	//			avl<T> operator+(const T d) -- adds an element to the tree
+	//			avl(bool multiset = false) -- default constructor; a
+	//				multiset counts duplicates instead of dropping them
+	//			avl(const avl<T, Balance>& t) -- copy constructor (deep copy)
+	//			avl<T, Balance>& operator+=(const T d)
+	//				-- adds an element to the tree
+	//			avl<T, Balance> operator+(const T d)
+	//				-- a copy with an element added; copies the whole
+	//				tree, O(n).  sharedAvl<T> shares nodes between
+	//				copies for an O(log n) tree + x.
 	//			void insert(T d) -- adds an element to the tree
+	//			valueType min() const -- smallest element, O(1)
+	//			valueType max() const -- largest element, O(1)
+	//			T popMin() -- removes & returns the smallest element
+	//			T popMax() -- removes & returns the largest element
+	//			T popNode(node<T>* &cur) -- bst::popNode(), keeping the
+	//				ends up to date; likewise popLow() & popHigh().
+	//				Under lazy erase they bury the element instead
+	//			void delTree(node<T>* &cur) -- deletes a subtree
+	//			void setLazyErase(size_t tombstones) -- erase marks
+	//				nodes, purging past that many marks; 0 turns it off
+	//			size_t tombstones() const -- nodes marked, not yet purged
 	//			~avl() -- destructor	
 	//
 	//     non-inline:
-	//			avl<T>& operator=(const avl<T>& t) -- deep copy
-	//			avl<T>& operator+=(const avl<T>& t) -- adds an element to the tree
+	//			avl<T, Balance>& operator=(const avl<T, Balance>& t)
+	//				-- deep copy
+	//			avl<T, Balance>& operator+=(const avl<T, Balance>& t)
+	//				-- adds t's elements to the tree
+	//			avl<T, Balance>& unionWith(avl<T, Balance>& t)
+	//				-- adds t's elements, taking t's nodes
+	//			avl<T, Balance>& intersectWith(avl<T, Balance>& t)
+	//				-- keeps only elements also in t; empties t
+	//			avl<T, Balance>& subtract(avl<T, Balance>& t)
+	//				-- drops elements that are in t; empties t
+	//			void splitAt(const T& d, avl<T, Balance>& upper)
+	//				-- moves the elements not below d into upper
+	//			void extract(const T* first, const T* last,
+	//				avl<T, Balance>& taken) -- moves the nodes of a
+	//				sorted batch of elements into taken
+	//			avl<T, Balance>& append(avl<T, Balance>& t)
+	//				-- takes t's elements, all above this tree's
 	//			void insert(T d, node<T>* &cur) -- adds an element to the tree
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a copied batch of elements to the tree
+	//			int bulkInsert(vector<T>&& batch) -- adds a batch of
+	//				elements, sorting it in place and moving them in
+	//			iterator& insert(iterator& hint, T d)
+	//				-- adds an element next to hint, moving hint to it
+	//			iterator insert(iterator&& hint, T d) -- likewise, for a
+	//				temporary hint such as end()
+	//			bool erase(const T& d, node<T>* &cur)
+	//				-- removes d from the tree and rebalances
+	//			void purge() -- unlinks every tombstone in one pass
 	//			T popnode(node<T>* &cur) -- returns element in node deleted
 	//			T poplow(node<T>* &cur) -- returns element in leftmost node (deleted)
 	//			T popfirst(const T& d, node<T>* np)
 	//				-- returns element in first node matching d (deleted)
+	//			void compact() -- moves every node into contiguous chunks
+	//			void setCompactThreshold(size_t changes)
+	//				-- compacts after that many inserts and erases
+	//			size_t rotations() const -- single rotations made so far
+	//			void resetRotations() -- sets the rotation count to 0
 	//		protected:
 	//			node<T>* rotateRight(node<T> *nodeN) -- balances tree	
 	//			node<T>* rotateLeft(node<T> *nodeN) -- balances tree
@@ -59,46 +128,260 @@ namespace AW_BST
 	//			node<T>* rebalance(node<T> *&nodeN) -- balances tree
 	//			int getHeightDifference(const node<T> *const nodeN)const
 	//				-- returns the height difference between the left & right subtrees 
+	//			node<T>* buildBalanced(T* first, T* last,
+	//				const size_t* counts)
+	//				-- builds a balanced subtree, moving in sorted data
+	//			void attach(vector<node<T>*>& path, bool toLeft, T d)
+	//				-- hangs a new leaf off path.back() and rebalances
+	//			void pathTo(const T& d, vector<node<T>*>& path) const
+	//				-- the path from the root to d's node
+	//			node<T>* join(node<T>* left, node<T>* middle,
+	//				node<T>* right) -- links two trees through middle
+	//			node<T>* join(node<T>* left, node<T>* right)
+	//				-- links two trees
+	//			node<T>* splitLast(node<T>* np, node<T>*& last)
+	//				-- unlinks the largest node of a subtree
+	//			void split(node<T>* np, const T& d, node<T>*& left,
+	//				node<T>*& match, node<T>*& right)
+	//				-- cuts a subtree into the parts below and above d
+	//			node<T>* unite(node<T>* a, node<T>* b, int forks)
+	//			node<T>* intersect(node<T>* a, node<T>* b, int forks)
+	//			node<T>* difference(node<T>* a, node<T>* b, int forks)
+	//				-- the set operations on detached subtrees
+	//			node<T>* extract(node<T>* np, const T* first,
+	//				const T* last, node<T>*& taken) -- unlinks a sorted
+	//				batch of elements from a detached subtree
+	//			void freeTree(node<T>* np) -- deletes a detached subtree
+	//			void countOnce(node<T>* np) -- sets every count in a
+	//				subtree to 1, for a set taking a multiset's nodes
+	//			T popEnd(bool high) -- removes the smallest or largest
+	//				element
+	//			void findEnds() -- finds the smallest & largest nodes
+	//			void trackNew(node<T>* np) -- notes a newly linked node
+	//			void trackGone(const node<T>* np) -- notes an unlinked
+	//				node, once the tree is whole
+	//			bool erase(const T& d, node<T>* &cur, bool& endGone)
+	//				-- removes d, noting whether an end node went
+	//			bool bury(const T& d) -- marks d's node a tombstone
+	//			T buryFrom(const node<T>* np, int end) -- buries np's
+	//				element, or the lowest or highest live one below np
 	//
 	//
 	// History Log: 
 	//					May 20, 2008, PB  completed version 1.0 
 	//					05-31-17 AW completed v 1.1
+	//					10-19-26 AW added bulkInsert, O(log n) insert
+	//					10-19-26 AW added erase
+	//					10-19-26 AW added hinted insert
+	//					10-19-26 AW added multiset mode
+	//					10-19-26 AW added compact
+	//					10-19-26 AW added union, intersection & difference
+	//					10-19-26 AW added balancing policies
+	//					10-19-26 AW added min, max, popMin & popMax
+	//					10-19-26 AW added splitAt & append
+	//					10-19-26 AW added lazy erase
+	//					10-19-26 AW added extract
 	//------------------------------------------------------------------- 
 
-	template<class T>
+	template<class T, class Balance = avlBalance>
 	class avl : public bst<T>
 	{
 	public:
-		avl() : bst() {}
-		avl(const avl<T>& t) : bst(t) {}
-		avl<T>& operator=(const avl<T>& t);
-		avl<T>& operator+=(const avl<T>& t);
-		avl<T>& operator+=(const T d) { insert(d); return *this; }
-		avl<T> operator+(const T d)
+		typedef typename bst<T>::iterator iterator;
+		typedef typename node<T>::valueType valueType;
+		using bst<T>::isempty;
+		using bst<T>::end;
+		using bst<T>::last;
+		using bst<T>::lowerBound;
+
+		explicit avl(bool multiset = false) : bst<T>(multiset),
+			m_churn(0), m_compactAfter(0), m_rotations(0),
+			m_low(nullptr), m_high(nullptr), m_tombstones(0),
+			m_purgeAfter(0) {}
+		avl(const avl<T, Balance>& t) : bst<T>(t), m_churn(0),
+			m_compactAfter(t.m_compactAfter), m_rotations(0),
+			m_graves(t.m_graves), m_tombstones(t.m_tombstones),
+			m_purgeAfter(t.m_purgeAfter)
+			{ findEnds(); }
+		avl<T, Balance>& operator=(const avl<T, Balance>& t);
+		avl<T, Balance>& operator+=(const avl<T, Balance>& t);
+		avl<T, Balance>& unionWith(avl<T, Balance>& t);
+		avl<T, Balance>& intersectWith(avl<T, Balance>& t);
+		avl<T, Balance>& subtract(avl<T, Balance>& t);
+		void splitAt(const T& d, avl<T, Balance>& upper);
+		void extract(const T* first, const T* last, avl<T, Balance>& taken);
+		avl<T, Balance>& append(avl<T, Balance>& t);
+		avl<T, Balance>& operator+=(const T d) { insert(d); return *this; }
+		avl<T, Balance> operator+(const T d)
+		{
+			avl<T, Balance> temp = *this; temp.insert(d); return temp;
+		}
+		bool insert(T d)
 		{
-			avl<T> temp = *this; temp.insert(d); return temp;
+			reserveRoom(1);
+			bool inserted = insert(std::move(d), root);
+			if (inserted)
+				noteChurn();
+			return inserted;
 		}
-		bool insert(T d) { return insert(d, root); }
 		bool insert(T d, node<T>* &cur);
+		iterator& insert(iterator& hint, T d);
+		iterator insert(iterator&& hint, T d)
+			{ insert(hint, d); return std::move(hint); }
+		template<class InputIt>
+		int bulkInsert(InputIt first, InputIt last)
+			{ return bulkInsert(vector<T>(first, last)); }
+		int bulkInsert(vector<T>&& batch);
+		bool erase(const T& d)
+		{
+			bool erased = (m_purgeAfter != 0) ? bury(d) : erase(d, root);
+			if (erased)
+				noteChurn();
+			return erased;
+		}
+		bool erase(const T& d, node<T>* &cur)
+		{
+			bool endGone = false;
+			bool erased = erase(d, cur, endGone);
+			if (endGone)
+				findEnds();
+			return erased;
+		}
 		T popnode(node<T>* &cur);
 		T poplow(node<T>* &cur);
 		T popfirst(const T& d, node<T>* np);
+		valueType min() const
+		{
+			if (m_low == nullptr)
+				throw (invalid_argument("Tree is empty"));
+			return m_low->value();
+		}
+		valueType max() const
+		{
+			if (m_high == nullptr)
+				throw (invalid_argument("Tree is empty"));
+			return m_high->value();
+		}
+		T popMin() { return popEnd(false); }
+		T popMax() { return popEnd(true); }
+		T popNode(node<T>* &cur)
+		{
+			if (m_purgeAfter != 0)
+				return buryFrom(cur, 0);
+			T d = bst<T>::popNode(cur); findEnds(); return d;
+		}
+		T popLow(node<T>* &cur)
+		{
+			if (m_purgeAfter != 0)
+				return buryFrom(cur, -1);
+			T d = bst<T>::popLow(cur); findEnds(); return d;
+		}
+		T popHigh(node<T>* &cur)
+		{
+			if (m_purgeAfter != 0)
+				return buryFrom(cur, 1);
+			T d = bst<T>::popHigh(cur); findEnds(); return d;
+		}
+		void delTree() { delTree(root); }
+		void delTree(node<T>* &cur)
+		{
+			bst<T>::delTree(cur);
+			if (root == nullptr)
+			{
+				m_graves.clear();
+				m_tombstones = 0;
+			}
+			findEnds();
+		}
+		void compact();
+		void setCompactThreshold(size_t changes)
+			{ m_compactAfter = changes; }
+		void setLazyErase(size_t tombstones)
+		{
+			m_purgeAfter = tombstones;
+			if (m_graves.size() > m_purgeAfter)
+				purge();
+		}
+		size_t tombstones() const { return m_tombstones; }
+		void purge();
+		size_t rotations() const
+			{ return m_rotations.load(memory_order_relaxed); }
+		void resetRotations() { m_rotations.store(0); }
 		~avl() { delTree(root); }
 
 	protected:
+		using bst<T>::root;
+		using bst<T>::parentptr;
+		using bst<T>::m_multiset;
+		using bst<T>::reserveRoom;
+
 		node<T>* rotateRight(node<T> *nodeN);
 		node<T>* rotateLeft(node<T> *nodeN);
 		node<T>* rotateRightLeft(node<T> *nodeN);
 		node<T>* rotateLeftRight(node<T> *nodeN);
 		node<T>* rebalance(node<T> *&nodeN);
 		int getHeightDifference(const node<T> *const nodeN)const;
+		node<T>* buildBalanced(T* first, T* last, const size_t* counts);
+		void attach(vector<node<T>*>& path, bool toLeft, T d);
+		void pathTo(const T& d, vector<node<T>*>& path) const
+		{   // pre: d is in the tree
+			path.clear();
+			for (node<T>* cur = root; cur != nullptr;
+				cur = cur->child(cur->value() < d))
+			{
+				path.push_back(cur);
+				if (d == cur->value())
+					break;
+			}
+		}
+		node<T>* join(node<T>* left, node<T>* middle, node<T>* right);
+		node<T>* join(node<T>* left, node<T>* right);
+		node<T>* splitLast(node<T>* np, node<T>*& last);
+		void split(node<T>* np, const T& d, node<T>*& left,
+			node<T>*& match, node<T>*& right);
+		node<T>* unite(node<T>* a, node<T>* b, int forks);
+		node<T>* intersect(node<T>* a, node<T>* b, int forks);
+		node<T>* difference(node<T>* a, node<T>* b, int forks);
+		node<T>* extract(node<T>* np, const T* first, const T* last,
+			node<T>*& taken);
+		static int forkDepth();
+		static void freeTree(node<T>* np);
+		static void countOnce(node<T>* np);
+		T popEnd(bool high);
+		void findEnds();
+		bool erase(const T& d, node<T>* &cur, bool& endGone);
+		bool bury(const T& d);
+		T buryFrom(const node<T>* np, int end);
+		void trackNew(node<T>* np)
+		{
+			if (m_low == nullptr || np->value() < m_low->value())
+				m_low = np;
+			if (m_high == nullptr || m_high->value() < np->value())
+				m_high = np;
+		}
+		void trackGone(const node<T>* np)   // call once the tree is whole
+			{ if (np == m_low || np == m_high) findEnds(); }
+		void noteChurn()
+		{
+			if (m_compactAfter != 0 && ++m_churn >= m_compactAfter)
+				compact();
+		}
+
+		size_t m_churn;         // inserts and erases since the last compact
+		size_t m_compactAfter;  // 0 never compacts automatically
+		atomic<size_t> m_rotations;  // set operations rotate on many threads
+		node<T>* m_low;         // leftmost node, nullptr when empty
+		node<T>* m_high;        // rightmost node
+		vector<node<T>*> m_spine;   // reused by popEnd() and bury()
+		vector<T> m_graves;     // keys buried since the last purge
+		size_t m_tombstones;    // nodes marked erased, still linked
+		size_t m_purgeAfter;    // graves to purge past; 0 erases at once
 	};
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline avl<T>& avl<T>::operator=(const avl<T>& t)
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::operator=(const avl<T, Balance>& t)
 	// Title:		Overloaded equal operator for avl class
 	// Description: Sets *this avl tree equal to t
 	//
@@ -116,12 +399,12 @@ namespace AW_BST
 	//				delTree()
 	//				node<T>; constructor
 	// Called By:	main()
-	// Parameters:	const avl<T>& t; the tree to set *this equal to
+	// Parameters:	const avl<T, Balance>& t; the tree to set *this equal to
 	// Returns:		*this; an avl tree that is equal to t
 	// History Log: 06-02-17 AW Completed v 1.0
 	//------------------------------------------------------------------------
-	template<class T>
-	inline avl<T>& avl<T>::operator=(const avl<T>& t)
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::operator=(const avl<T, Balance>& t)
 	{
 		if (this != &t)
 		{
@@ -132,14 +415,21 @@ namespace AW_BST
 			{
 				root = new node<T>(*(t.root));
 			}
+			findEnds();
+			m_multiset = t.m_multiset;
+			m_compactAfter = t.m_compactAfter;
+			m_churn = 0;
+			m_graves = t.m_graves;
+			m_tombstones = t.m_tombstones;
+			m_purgeAfter = t.m_purgeAfter;
 		}
 		return *this;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline avl<T>& avl<T>::operator+=(const avl<T>& t)
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::operator+=(const avl<T, Balance>& t)
 	// Title:		Adds one tree to another
 	// Description: Adds contents of one tree to another tree
 	//
@@ -153,37 +443,335 @@ namespace AW_BST
 	//
 	// Input:		N/A
 	// Output:		N/A
-	// Calls:		avl<T>; constructor
-	//				isempty();
-	//				popNode()
-	//				getroot();
-	//				insert()
+	// Calls:		avl<T, Balance>; copy constructor
+	//				unionWith()
 	// Called By:	main()
-	// Parameters:	const avl<T>& t; the tree to add the contents of
+	// Parameters:	const avl<T, Balance>& t; the tree to add the contents of
 	// Returns:		*this; a tree that is the contains both it's original
 	//				data as well as the data contained in t
 	// History Log: 06-02-17 AW Completed v 1.0
-	// Known Bugs:	Seems ineffecient
+	//				10-19-26 AW carries duplicate counts across
+	//				10-19-26 AW joins a copy of t instead of reinserting
+	//					its elements one at a time
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::operator+=(const avl<T, Balance>& t)
+	{
+		avl<T, Balance> tempTree = t;
+		return unionWith(tempTree);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::unionWith(avl<T, Balance>& t)
+	// Title:		Union of two trees
+	// Description: Merges t into *this by splitting and joining subtrees
+	//				rather than inserting element by element, so merging m
+	//				elements into n costs O(m log(n/m + 1)).  t's nodes are
+	//				moved, not copied, and t is left empty.  The two halves
+	//				of each large split are merged on separate threads.  A
+	//				multiset adds the counts of matching elements; a set
+	//				keeps one, even of a multiset's elements.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		unite()
+	//				forkDepth()
+	//				countOnce()
+	// Called By:	operator+=(const avl<T, Balance>& t)
+	//				main()
+	// Parameters:	avl<T, Balance>& t; the tree to take the elements of
+	// Returns:		*this; the union of both trees
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW a set drops a multiset argument's counts
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::unionWith(avl<T, Balance>& t)
+	{
+		if (this == &t)
+		{
+			avl<T, Balance> tempTree = t;
+			return unionWith(tempTree);
+		}
+		reserveRoom(t.size());
+		purge();
+		t.purge();
+		if (!m_multiset && t.m_multiset)
+			countOnce(t.root);
+		node<T>* a = root;
+		root = nullptr;    // detached while the threads work on it
+		node<T>* b = t.root;
+		t.root = nullptr;
+		t.m_low = t.m_high = nullptr;
+		root = unite(a, b, forkDepth());
+		findEnds();
+		noteChurn();
+		return *this;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::intersectWith(avl<T, Balance>& t)
+	// Title:		Intersection of two trees
+	// Description: Keeps only the elements of *this that are also in t,
+	//				by splitting and joining subtrees, in O(m log(n/m + 1))
+	//				for trees of m and n elements.  t is left empty.  A
+	//				multiset keeps the smaller of the two counts.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		intersect()
+	//				forkDepth()
+	// Called By:	main()
+	// Parameters:	avl<T, Balance>& t; the tree to intersect with
+	// Returns:		*this; the intersection of both trees
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::intersectWith(avl<T, Balance>& t)
+	{
+		if (this == &t)
+			return *this;
+		purge();
+		t.purge();
+		node<T>* a = root;
+		root = nullptr;
+		node<T>* b = t.root;
+		t.root = nullptr;
+		t.m_low = t.m_high = nullptr;
+		root = intersect(a, b, forkDepth());
+		findEnds();
+		noteChurn();
+		return *this;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::subtract(avl<T, Balance>& t)
+	// Title:		Difference of two trees
+	// Description: Removes from *this every element that is in t, by
+	//				splitting and joining subtrees, in O(m log(n/m + 1))
+	//				for trees of m and n elements.  t is left empty.  A
+	//				multiset takes t's count off each matching element,
+	//				dropping it once nothing is left.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		difference()
+	//				forkDepth()
+	//				delTree()
+	// Called By:	main()
+	// Parameters:	avl<T, Balance>& t; the elements to remove
+	// Returns:		*this; the elements of *this not in t
+	// History Log: 10-19-26 AW Completed v 1.0
 	//------------------------------------------------------------------------
-	template<class T>
-	inline avl<T>& avl<T>::operator+=(const avl<T>& t)
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::subtract(avl<T, Balance>& t)
 	{
-		avl<char> tempTree = t;
-		while (!tempTree.isempty())
+		if (this == &t)
 		{
-			T temp = popNode(tempTree.getroot());
-			insert(temp, root);
+			delTree(root);
+			return *this;
 		}
+		purge();
+		t.purge();
+		node<T>* a = root;
+		root = nullptr;
+		node<T>* b = t.root;
+		t.root = nullptr;
+		t.m_low = t.m_high = nullptr;
+		root = difference(a, b, forkDepth());
+		findEnds();
+		noteChurn();
+		return *this;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::splitAt(const T& d,
+	//				avl<T, Balance>& upper)
+	// Title:		Splits a tree in two at an element
+	// Description: Keeps the elements below d and moves every element
+	//				not below d into upper, replacing whatever upper held.
+	//				Nodes are relinked, not copied: O(log n) plus the cost
+	//				of emptying upper.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split()
+	//				join()
+	//				delTree()
+	//				findEnds()
+	// Called By:	main()
+	// Parameters:	const T& d; the smallest element upper may receive
+	//				avl<T, Balance>& upper; receives the upper part
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::splitAt(const T& d, avl<T, Balance>& upper)
+	{
+		if (this == &upper)
+			return;
+		upper.delTree(upper.root);
+		upper.m_multiset = m_multiset;
+		purge();
+		node<T>* below;
+		node<T>* match;
+		node<T>* above;
+		split(root, d, below, match, above);
+		root = below;
+		upper.root = match ? join(nullptr, match, above) : above;
+		findEnds();
+		upper.findEnds();
+		noteChurn();
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::extract(const T* first,
+	//				const T* last, avl<T, Balance>& taken)
+	// Title:		Moves a batch of elements into another tree
+	// Description: Unlinks the node of every element in the sorted range
+	//				[first, last) that is in the tree, every copy of it in
+	//				a multiset, and moves those nodes into taken, replacing
+	//				whatever taken held.  Elements not in the tree are
+	//				skipped.  Nothing is allocated or deleted, so a caller
+	//				holding a lock can free taken after releasing it.
+	//				O(e log(n / e + 1)) for e elements.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		extract(np, first, last, taken)
+	//				delTree()
+	//				findEnds()
+	// Called By:	main()
+	// Parameters:	const T* first, last; the elements to move, ascending
+	//				avl<T, Balance>& taken; receives their nodes
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::extract(const T* first, const T* last,
+		avl<T, Balance>& taken)
+	{
+		if (this == &taken)
+			return;
+		taken.delTree(taken.root);
+		taken.m_multiset = m_multiset;
+		purge();
+		node<T>* moved;
+		root = extract(root, first, last, moved);
+		taken.root = moved;
+		findEnds();
+		taken.findEnds();
+		noteChurn();
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline avl<T, Balance>& avl<T, Balance>::append(avl<T, Balance>& t)
+	// Title:		Concatenates two trees
+	// Description: Takes every element of t, all of which must lie above
+	//				this tree's largest, by joining the two trees in
+	//				O(log n).  t is left empty.  The inverse of splitAt().
+	//				A set appending a multiset keeps one of each element,
+	//				which costs a pass over t's nodes.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		join()
+	//				findEnds()
+	//				countOnce()
+	// Called By:	main()
+	// Parameters:	avl<T, Balance>& t; the elements to add
+	// Returns:		*this; both trees' elements
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW a set drops a multiset argument's counts
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline avl<T, Balance>& avl<T, Balance>::append(avl<T, Balance>& t)
+	{
+		if (this == &t || t.isempty())
+			return *this;
+		purge();
+		t.purge();
+		if (!isempty() && !(m_high->value() < t.m_low->value()))
+			throw (invalid_argument(
+				"Appended elements must follow the tree's largest"));
+		reserveRoom(t.size());
+		if (!m_multiset && t.m_multiset)
+			countOnce(t.root);
+		root = join(root, t.root);
+		t.root = nullptr;
+		t.m_low = t.m_high = nullptr;
+		findEnds();
+		noteChurn();
 		return *this;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline bool avl<T>::insert(T d, node<T>*& cur)
+	// Function:	template<class T, class Balance>
+	//				inline bool avl<T, Balance>::insert(T d, node<T>*& cur)
 	// Title:		Insert an element
 	// Description: Inserts an element into the avl tree, does not allow 
-	//				duplicate insertions.
+	//				duplicate insertions.  A multiset bumps the count of
+	//				the matching node instead.
 	//
 	// Programmer:	Anthony Waddell
 	// Date:		05-30-17
@@ -195,9 +783,8 @@ namespace AW_BST
 	//
 	// Input:		<T> d; user supplied data from console
 	// Output:		N/A
-	// Calls:		isempty()
-	//				node<T> *temp; constructor
-	//				setHeight()
+	// Calls:		node<T> *temp; constructor
+	//				update()
 	//				value()
 	//				insert(); recursively
 	//				rebalance();
@@ -205,48 +792,379 @@ namespace AW_BST
 	//				operator+(const T d)
 	//				bool insert(T d, node<T>* &cur);
 	//				bool insert(T d) ; recursively
+	//				bulkInsert()
 	//				main()
 	// Parameters:	T d; the data tp be inserted into the avl tree
 	//				node<T>* &cur; parent node of the node to be inserted
 	// Returns:		true if element was inserted; false if not
 	// History Log: 05-30-17 AW Completed v 1.0
+	//				10-19-26 AW only updates heights along the insertion
+	//					path instead of the whole tree; returns false only
+	//					for duplicates
+	//				10-19-26 AW counts duplicates in a multiset
+	//				10-19-26 AW revives a tombstone holding d
+	//				10-19-26 AW a revived tombstone takes d's value
 	//------------------------------------------------------------------------
-	template<class T>
-	inline bool avl<T>::insert(T d, node<T>* &cur)
+	template<class T, class Balance>
+	inline bool avl<T, Balance>::insert(T d, node<T>* &cur)
 	{
-		bool duplicate = false;
+		bool inserted = false;
 		if (cur == nullptr)
 		{
-			cur = new node<T>(d);
-			if (isempty())
-				root = cur;
+			cur = new node<T>(std::move(d));
+			trackNew(cur);
+			return true;
+		}
+		if (d == cur->value())
+		{
+			if (cur->getCount() == 0)
+			{   // revives a tombstone, which may hold a stale value
+				cur->setdata(std::move(d));
+				cur->setCount(1);
+				m_tombstones--;
+				trackNew(cur);
+			}
+			else if (!m_multiset)
+				return inserted;
+			else
+				cur->setCount(cur->getCount() + 1);
+			cur->update();
+			return true;
 		}
+		else if (d < cur->value())
+			inserted = insert(std::move(d), cur->left);
 		else
+			inserted = insert(std::move(d), cur->right);
+		if (inserted)
 		{
-			if (d == cur->value())
-				return duplicate;
-			else if (d < cur->value())
+			cur->update();
+			rebalance(cur);
+		}
+		return inserted;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline typename avl<T, Balance>::iterator& avl<T, Balance>::insert(
+	//				iterator& hint, T d)
+	// Title:		Insert an element next to a hint
+	// Description: Inserts d directly before or after the element hint
+	//				refers to, without descending from the root, when d
+	//				belongs there, and moves hint to d.  The hint's path
+	//				is extended and trimmed in place, never copied, so a
+	//				loop that keeps passing the same iterator allocates
+	//				nothing.  end() as the hint appends after the largest
+	//				element: the cached largest node decides whether d
+	//				fits, and only then is the right spine walked, the
+	//				same nodes whose weights the insert recounts anyway.
+	//				Sorted or nearly sorted input costs amortized O(1)
+	//				restructuring per key; the weight recount keeps each
+	//				insert O(log n) to walk.  A hint that does not fit
+	//				costs one descent from the root, which rebuilds its
+	//				path; while tombstones are linked every insert is a
+	//				normal insert.  A multiset counts d
+	//				again when it equals the hint.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		attach()
+	//				insert()
+	//				pathTo()
+	// Called By:	insert(iterator&& hint, T d)
+	//				main()
+	// Parameters:	iterator& hint; an iterator into this tree or end()
+	//				T d; the data to be inserted into the avl tree
+	// Returns:		hint, now at d (whether or not d was new)
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW ignores the hint while tombstones are linked
+	//				10-19-26 AW moves the hint in place instead of copying
+	//					its path; end() checks the cached largest node
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline typename avl<T, Balance>::iterator& avl<T, Balance>::insert(iterator& hint, T d)
+	{
+		reserveRoom(1);
+		vector<node<T>*>& path = hint.getPath();
+		if (m_tombstones != 0)
+		{   // a hint's neighbors may be tombstones; descend from the root
+			insert(d, root);
+			pathTo(d, path);
+			return hint;
+		}
+		if (isempty())
+		{
+			root = new node<T>(d);
+			trackNew(root);
+			path.assign(1, root);
+			return hint;
+		}
+		if (path.empty())
+		{   // append after the largest node
+			if (m_high->value() < d)
+			{
+				path.reserve(root->getHeight() + 1);   // one allocation
+				hint.pushRightSpine(root);
+				attach(path, false, d);
+				return hint;
+			}
+		}
+		else if (d == path.back()->value())
+		{
+			if (m_multiset)
+			{
+				path.back()->setCount(path.back()->getCount() + 1);
+				for (size_t i = path.size(); i-- > 0; )
+					path[i]->update();
+			}
+			return hint;
+		}
+		else if (path.back()->value() < d)
+		{   // d must come before hint's successor
+			node<T>* cur = path.back();
+			if (cur->right == nullptr)
+			{
+				size_t i = path.size() - 1;
+				while (i > 0 && path[i - 1]->right == path[i])
+					i--;
+				if (i == 0 || d < path[i - 1]->value())
+				{
+					attach(path, false, d);
+					return hint;
+				}
+			}
+			else
+			{
+				for (cur = cur->right; cur != nullptr; cur = cur->left)
+					path.push_back(cur);
+				if (d < path.back()->value())
+				{
+					attach(path, true, d);
+					return hint;
+				}
+			}
+		}
+		else
+		{   // d must come after hint's predecessor
+			node<T>* cur = path.back();
+			if (cur->left == nullptr)
 			{
-				insert(d, cur->left);
-				duplicate = true;
-				rebalance(cur);
+				size_t i = path.size() - 1;
+				while (i > 0 && path[i - 1]->left == path[i])
+					i--;
+				if (i == 0 || path[i - 1]->value() < d)
+				{
+					attach(path, true, d);
+					return hint;
+				}
 			}
 			else
 			{
-				insert(d, cur->right);
-				duplicate = true;
-				rebalance(cur);
+				for (cur = cur->left; cur != nullptr; cur = cur->right)
+					path.push_back(cur);
+				if (path.back()->value() < d)
+				{
+					attach(path, false, d);
+					return hint;
+				}
+			}
+		}
+		path.clear();   // a bad hint: one descent from the root
+		for (node<T>* cur = root; cur != nullptr; cur = cur->child(cur->value() < d))
+		{
+			path.push_back(cur);
+			if (d == cur->value())
+			{
+				if (m_multiset)
+				{
+					cur->setCount(cur->getCount() + 1);
+					for (size_t i = path.size(); i-- > 0; )
+						path[i]->update();
+				}
+				return hint;
+			}
+		}
+		attach(path, d < path.back()->value(), d);
+		return hint;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline int avl<T, Balance>::bulkInsert(
+	//				vector<T>&& batch)
+	// Title:		Insert a batch of elements
+	// Description: Sorts the batch in place and drops duplicates (a
+	//				multiset counts them instead), then builds the tree
+	//				directly if it is empty, otherwise inserts the keys in
+	//				order so consecutive descents share a path.  The
+	//				elements are moved into the nodes, never copied, and
+	//				batch is left empty with its capacity, ready for
+	//				reuse.  The range overload copies its range into a
+	//				batch first.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		isempty()
+	//				buildBalanced()
+	//				insert()
+	// Called By:	loadKeys()
+	// Parameters:	vector<T>&& batch; the elements to insert, consumed
+	// Returns:		int count; the number of elements actually inserted
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW sorts an rvalue batch in place and moves
+	//					its elements into the nodes
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline int avl<T, Balance>::bulkInsert(vector<T>&& batch)
+	{
+		int count = 0;
+		if (batch.empty())
+			return count;
+		reserveRoom(batch.size());
+		sort(batch.begin(), batch.end());
+		if (m_multiset && isempty())
+		{   // one node per run of equal keys
+			vector<size_t> counts;
+			size_t runs = 0;
+			for (size_t i = 0; i < batch.size(); i++)
+			{
+				if (i == 0 || !(batch[i] == batch[runs - 1]))
+				{
+					if (runs != i)
+						batch[runs] = std::move(batch[i]);
+					runs++;
+					counts.push_back(0);
+				}
+				counts.back()++;
+			}
+			count = static_cast<int>(batch.size());
+			root = buildBalanced(batch.data(), batch.data() + runs,
+				counts.data());
+			findEnds();
+			batch.clear();
+			return count;
+		}
+		if (!m_multiset)
+			batch.erase(unique(batch.begin(), batch.end()), batch.end());
+		if (isempty())
+		{
+			count = static_cast<int>(batch.size());
+			root = buildBalanced(batch.data(), batch.data() + batch.size(),
+				nullptr);
+			findEnds();
+			batch.clear();
+			return count;
+		}
+		for (size_t i = 0; i < batch.size(); i++)
+		{
+			if (insert(std::move(batch[i]), root))
+				count++;
+		}
+		batch.clear();
+		return count;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline bool avl<T, Balance>::erase(const T& d, node<T>*& cur,
+	//				bool& endGone)
+	// Title:		Remove an element
+	// Description: Removes d from the subtree rooted at cur, descending by
+	//				key, and rebalances every node on the way back up.  A
+	//				node with two children takes its in-order successor's
+	//				data and the successor is erased from the right subtree.
+	//				A multiset removes one copy, dropping the node only
+	//				when its count reaches zero.  Deleting a cached end
+	//				node sets endGone; the two-argument erase() then
+	//				refreshes the ends once the tree is whole again.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		erase(); recursively
+	//				update()
+	//				rebalance()
+	// Called By:	bool erase(const T& d, node<T>* &cur)
+	// Parameters:	const T& d; the data to remove
+	//				node<T>* &cur; root of the subtree to remove it from
+	//				bool& endGone; set if m_low or m_high was deleted
+	// Returns:		true if d was found and removed; false if not
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW leaves refreshing the ends to the caller
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline bool avl<T, Balance>::erase(const T& d, node<T>* &cur,
+		bool& endGone)
+	{
+		bool erased = false;
+		if (cur == nullptr)
+			return erased;
+		if (d == cur->value())
+		{
+			if (cur->getCount() > 1)
+			{
+				cur->setCount(cur->getCount() - 1);
+				cur->update();
+				return true;
+			}
+			if (cur->left == nullptr || cur->right == nullptr)
+			{
+				node<T>* doomed = cur;
+				cur = (cur->left != nullptr) ? cur->left : cur->right;
+				if (doomed == m_low || doomed == m_high)
+					endGone = true;
+				delete doomed;
+				return true;
 			}
-			if (root != nullptr)
-				root->setHeight();
+			node<T>* successor = cur->right;
+			while (successor->left != nullptr)
+				successor = successor->left;
+			cur->setdata(successor->value());
+			cur->setCount(successor->getCount());
+			successor->setCount(1);
+			erased = erase(successor->value(), cur->right, endGone);
+		}
+		else if (d < cur->value())
+			erased = erase(d, cur->left, endGone);
+		else
+			erased = erase(d, cur->right, endGone);
+		if (erased)
+		{
+			cur->update();
+			rebalance(cur);
 		}
-		return duplicate;
+		return erased;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline T avl<T>::popnode(node<T>*& cur)
+	// Function:	template<class T, class Balance>
+	//				inline T avl<T, Balance>::popnode(node<T>*& cur)
 	// Title:		Removes a node from the tree
 	// Description: Pops a node off of the avl tree and returns it's data
 	//
@@ -262,25 +1180,30 @@ namespace AW_BST
 	// Output:		N/A
 	// Calls:		bst::popNode()
 	//				rebalance()
+	//				buryFrom()
 	// Called By:	main()
 	// Parameters:	node<T>*& cur; the node to remove from the avl tree
 	// Returns:		T contents; the piece of m_data contained in the node
 	//				that was removed
 	// History Log: 05-31-17 AW Began v 1.0
+	//				10-19-26 AW buries the element under lazy erase
 	// Known Bugs:  Does not rebalance the tree after removal
 	//------------------------------------------------------------------------
-	template<class T>
-	inline T avl<T>::popnode(node<T>*& cur)
+	template<class T, class Balance>
+	inline T avl<T, Balance>::popnode(node<T>*& cur)
 	{
-		T contents = bst::popNode(cur);
+		if (m_purgeAfter != 0)
+			return buryFrom(cur, 0);
+		T contents = bst<T>::popNode(cur);
 		rebalance(cur);
+		findEnds();
 		return contents;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline T avl<T>::poplow(node<T>*& cur)
+	// Function:	template<class T, class Balance>
+	//				inline T avl<T, Balance>::poplow(node<T>*& cur)
 	// Title:		Removes the leftmost child
 	// Description: Pops the left-most child off of the node passed in
 	//				and returns it's data
@@ -297,25 +1220,30 @@ namespace AW_BST
 	// Output:		N/A
 	// Calls:		bst::popLow()
 	//				rebalance()
+	//				buryFrom()
 	// Called By:	main()
 	// Parameters:	node<T>*& cur; the node to remove from the avl tree
 	// Returns:		T contents; the piece of m_data contained in the node
 	//				that was removed
 	// History Log: 05-31-17 AW Began v 1.0
+	//				10-19-26 AW buries the element under lazy erase
 	// Known Bugs:  Does not rebalance the tree after removal
 	//------------------------------------------------------------------------
-	template<class T>
-	inline T avl<T>::poplow(node<T>*& cur)
+	template<class T, class Balance>
+	inline T avl<T, Balance>::poplow(node<T>*& cur)
 	{
-		T contents = bst::popLow(cur);
+		if (m_purgeAfter != 0)
+			return buryFrom(cur, -1);
+		T contents = bst<T>::popLow(cur);
 		rebalance(cur);
+		findEnds();
 		return contents;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline T avl<T>::popfirst(const T & d, node<T>* np)
+	// Function:	template<class T, class Balance>
+	//				inline T avl<T, Balance>::popfirst(const T & d, node<T>* np)
 	// Title:		Removes first occurence of node
 	// Description: Pops the node containing the first occurence of that data
 	//				passed in and returns that data
@@ -339,8 +1267,8 @@ namespace AW_BST
 	// History Log: 05-31-17 AW Began v 1.0
 	// Known Bugs:  Does not rebalance the tree after removal
 	//------------------------------------------------------------------------
-	template<class T>
-	inline T avl<T>::popfirst(const T & d, node<T>* np)
+	template<class T, class Balance>
+	inline T avl<T, Balance>::popfirst(const T & d, node<T>* np)
 	{
 		//bool removed = false;
 		////node<T> *temp = *this->getroot();
@@ -363,10 +1291,10 @@ namespace AW_BST
 		//	return  contents;
 		//}
 
-		node<char>* parent = *parentptr;
-		T contents = bst::popFirstOf(d, np);
+		T contents = bst<T>::popFirstOf(d, np);
 		/*while (getHeightDifference(parent) > 1 || getHeightDifference(parent) < -1)*/
 		rebalance(np);
+		findEnds();
 		if (!contents)
 			cout << "Could not locate node containing that data in tree" << endl;
 		return contents;
@@ -374,8 +1302,8 @@ namespace AW_BST
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline node<T>* avl<T>::rotateRight(node<T>* nodeN)
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::rotateRight(node<T>* nodeN)
 	// Title:		Right Right rotation
 	// Description: Performs a right right rotation to balance the tree
 	//
@@ -390,32 +1318,34 @@ namespace AW_BST
 	// Input:		N/A
 	// Output:		N/A
 	// Calls:		node<T> *temp; constructor
-	//				setHeight()
+	//				update()
 	// Called By:	rebalance()
 	//				rotateRightLeft()
 	//				rotateLeftRight()
 	// Parameters:	node<T>* nodeN; the node to balance
 	// Returns:		temp; the parent node to perform a right right rotation on
 	// History Log: 05-30-17 AW Completed v 1.0
+	//				10-19-26 AW counts rotations
 	//------------------------------------------------------------------------
-	template<class T>
-	inline node<T>* avl<T>::rotateRight(node<T>* nodeN)
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::rotateRight(node<T>* nodeN)
 	{
 		node<T> *temp;
+		m_rotations.fetch_add(1, memory_order_relaxed);
 		// Get temp to middle
 		temp = nodeN->left;
 		nodeN->left = temp->right;
 		// Bring parent node to temp right to make into triangle
 		temp->right = nodeN;
-		nodeN->setHeight();
-		temp->setHeight();
+		nodeN->update();
+		temp->update();
 		return temp;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline node<T>* avl<T>::rotateLeft(node<T>* nodeN)
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::rotateLeft(node<T>* nodeN)
 	// Title:		Left Left rotation
 	// Description: Performs a left left rotation to balance the tree
 	//
@@ -430,32 +1360,34 @@ namespace AW_BST
 	// Input:		N/A
 	// Output:		N/A
 	// Calls:		node<T> *temp; constructor
-	//				setHeight()
+	//				update()
 	// Called By:	rebalance()
 	//				rotateRightLeft()
 	//				rotateLeftRight()
 	// Parameters:	node<T>* nodeN; the node to balance
 	// Returns:		temp; the parent node to perform a left left rotation on
 	// History Log: 05-30-17 AW Completed v 1.0
+	//				10-19-26 AW counts rotations
 	//------------------------------------------------------------------------
-	template<class T>
-	inline node<T>* avl<T>::rotateLeft(node<T>* nodeN)
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::rotateLeft(node<T>* nodeN)
 	{
 		node<T> *temp;
+		m_rotations.fetch_add(1, memory_order_relaxed);
 		// Get temp as middle nide
 		temp = nodeN->right;
 		nodeN->right = temp->left;
 		// Bring parent node down to form balanced trianlge
 		temp->left = nodeN;
-		nodeN->setHeight();
-		temp->setHeight();
+		nodeN->update();
+		temp->update();
 		return temp;
 	}
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline node<T>* avl<T>::rotateRightLeft(node<T>* nodeN)
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::rotateRightLeft(node<T>* nodeN)
 	// Title:		Right Left rotation
 	// Description: Performs a right left rotation to balance the tree
 	//
@@ -477,8 +1409,8 @@ namespace AW_BST
 	// Returns:		temp; the parent node to perform a right left rotation on
 	// History Log: 05-30-17 AW Completed v 1.0
 	//------------------------------------------------------------------------
-	template<class T>
-	inline node<T>* avl<T>::rotateRightLeft(node<T>* nodeN)
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::rotateRightLeft(node<T>* nodeN)
 	{
 		node<T> *temp;
 		// Prepare for left rotation
@@ -490,8 +1422,8 @@ namespace AW_BST
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline node<T>* avl<T>::rotateLeftRight(node<T>* nodeN)
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::rotateLeftRight(node<T>* nodeN)
 	// Title:		Left Right rotation
 	// Description: Performs a left right rotation to balance the tree
 	//
@@ -513,8 +1445,8 @@ namespace AW_BST
 	// Returns:		temp; the parent node to perform a left right rotation on
 	// History Log: 05-30-17 AW Completed v 1.0
 	//------------------------------------------------------------------------
-	template<class T>
-	inline node<T>* avl<T>::rotateLeftRight(node<T>* nodeN)
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::rotateLeftRight(node<T>* nodeN)
 	{
 		node<T> *temp;
 		// Prepare for right rotation
@@ -526,8 +1458,8 @@ namespace AW_BST
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline int avl<T>::getHeightDifference(const node<T>* 
+	// Function:	template<class T, class Balance>
+	//				inline int avl<T, Balance>::getHeightDifference(const node<T>* 
 	//				const nodeN) const
 	// Title:		Gets height difference
 	// Description: Gets the height difference between nodeN's left and right
@@ -551,8 +1483,8 @@ namespace AW_BST
 	//				nodeN's left and right child nodes
 	// History Log: 05-30-17 AW Completed v 1.0
 	//------------------------------------------------------------------------
-	template<class T>
-	inline int avl<T>::getHeightDifference(const node<T>* const nodeN) const
+	template<class T, class Balance>
+	inline int avl<T, Balance>::getHeightDifference(const node<T>* const nodeN) const
 	{
 		int m_leftHeight;
 		int m_rightHeight;
@@ -576,8 +1508,8 @@ namespace AW_BST
 
 	//------------------------------------------------------------------------
 	// Class:		avl.h
-	// Function:	template<class T>
-	//				inline node<T>* avl<T>::rebalance(node<T>*& nodeN)
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::rebalance(node<T>*& nodeN)
 	// Title:		Balances the avl tree
 	// Description: Performs various balances on the avl tree
 	//
@@ -597,22 +1529,28 @@ namespace AW_BST
 	//				rotateRightLeft()
 	//				rotateLeftRight()
 	// Called By:	insert()
+	//				erase()
 	// Parameters:	node<T>*& nodeN); the node to perform a balance on
 	// Returns:		node<T>* nodeN; the balanced node
 	// History Log: 05-30-17 AW Completed v 1.0
+	//				10-19-26 AW single rotation when the heavy child is
+	//					level, which only happens after a removal
+	//				10-19-26 AW allows the height difference the Balance
+	//					policy names; the rotations restore it for any
+	//					slack
 	//------------------------------------------------------------------------
-	template<class T>
-	inline node<T>* avl<T>::rebalance(node<T>*& nodeN)
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::rebalance(node<T>*& nodeN)
 	{
-		int leftImbalance = 1;
-		int rightImbalance = -1;
+		int leftImbalance = Balance::slack;
+		int rightImbalance = -Balance::slack;
 		int balance = getHeightDifference(nodeN);
 		if (nodeN == NULL)
 			return nodeN;
 		//If there are more elements on LHS
 		if (balance > leftImbalance)
 		{
-			if (getHeightDifference(nodeN->left) > 0)
+			if (getHeightDifference(nodeN->left) >= 0)
 			{
 				nodeN = rotateRight(nodeN);
 			}
@@ -624,7 +1562,7 @@ namespace AW_BST
 		//If there are more elements on RHS
 		else if (balance < rightImbalance)
 		{
-			if (getHeightDifference(nodeN->right) < 0)
+			if (getHeightDifference(nodeN->right) <= 0)
 			{
 				nodeN = rotateLeft(nodeN);
 			}
@@ -635,5 +1573,1171 @@ namespace AW_BST
 		}
 		return nodeN;
 	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::compact()
+	// Title:		Relays the tree out in contiguous chunks
+	// Description: Moves every node into 64K chunks (see nodeBlocks) in
+	//				depth-first (preorder) order, so each left child sits
+	//				right after its parent and an inorder walk moves
+	//				forward through memory.  The shape of the tree is
+	//				unchanged.  Nodes added later are allocated one at a
+	//				time as usual; a chunk is freed when its last node is
+	//				deleted.  A key type aligned more strictly than half
+	//				of max_align_t cannot be tagged, and its tree is left
+	//				as it is.  Invalidates iterators and node pointers.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		nodeBlocks::allocate()
+	//				node<T>; constructor
+	//				update()
+	// Called By:	noteChurn()
+	//				main()
+	// Parameters:	N/A
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW chunks found by address instead of a
+	//					global registry
+	// Known Bugs:	If copying a key throws, the tree is left untouched
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::compact()
+	{
+		m_churn = 0;
+		if (isempty() || alignof(node<T>) > nodeBlocks::TAG)
+			return;
+		// preorder list of the old nodes, with where each one hangs
+		vector<node<T>*> order;
+		vector<size_t> parentSlot;     // 2 * parent index + is right child
+		vector<pair<node<T>*, size_t>> pending(1, make_pair(root, size_t(0)));
+		while (!pending.empty())
+		{
+			node<T>* old = pending.back().first;
+			size_t slot = pending.back().second;
+			pending.pop_back();
+			size_t index = order.size();
+			order.push_back(old);
+			parentSlot.push_back(slot);
+			if (old->right != nullptr)
+				pending.push_back(make_pair(old->right, 2 * index + 1));
+			if (old->left != nullptr)
+				pending.push_back(make_pair(old->left, 2 * index));
+		}
+
+		size_t n = order.size();
+		vector<void*> slots;
+		nodeBlocks::allocate(sizeof(node<T>), n, slots);
+		size_t built = 0;
+		try
+		{
+			for (; built < n; built++)
+			{
+				node<T>* np = ::new (slots[built]) node<T>(order[built]->value());
+				np->setCount(order[built]->getCount());
+			}
+		}
+		catch (...)
+		{   // hand back what was built; the last release frees a chunk
+			for (size_t i = 0; i < n; i++)
+			{
+				if (i < built)
+					delete static_cast<node<T>*>(slots[i]);
+				else
+					nodeBlocks::release(slots[i], sizeof(node<T>));
+			}
+			throw;
+		}
+
+		root = static_cast<node<T>*>(slots[0]);
+		for (size_t i = 1; i < n; i++)
+		{
+			node<T>* parent = static_cast<node<T>*>(slots[parentSlot[i] / 2]);
+			(parentSlot[i] % 2 ? parent->right : parent->left)
+				= static_cast<node<T>*>(slots[i]);
+		}
+		for (size_t i = n; i-- > 0; )
+		{   // children follow their parents, so go backwards
+			static_cast<node<T>*>(slots[i])->update();
+			delete order[i];
+		}
+		findEnds();
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline T avl<T, Balance>::popEnd(bool high)
+	// Title:		Removes the smallest or largest element
+	// Description: Walks the left (or right) spine to the cached end node,
+	//				then either takes one copy off its count or unlinks it,
+	//				hanging its one child in its place.  Heights, weights
+	//				and balance are fixed only along that spine, so a pop
+	//				is O(log n) worst case with no whole-tree pass.  The
+	//				next end is the leftmost node of that child, or the
+	//				end node's parent; rotations move nodes but not the
+	//				data in them, so the cached pointers stay good.
+	//				With lazy erase on, the end is buried instead.
+	//				Throws invalid_argument if the tree is empty.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		update()
+	//				rebalance()
+	//				bury()
+	//				noteChurn()
+	// Called By:	popMin()
+	//				popMax()
+	// Parameters:	bool high; true to remove the largest element
+	// Returns:		T contents; the element removed
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW buries the end under lazy erase
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline T avl<T, Balance>::popEnd(bool high)
+	{
+		node<T>* end = high ? m_high : m_low;
+		if (end == nullptr)
+			throw (invalid_argument("Tree is empty"));
+		T contents = end->value();
+		if (m_purgeAfter != 0)
+		{   // the end need not be on the spine past a tombstone
+			bury(contents);
+			noteChurn();
+			return contents;
+		}
+		vector<node<T>*>& path = m_spine;
+		path.clear();
+		for (node<T>* cur = root; cur != end; cur = cur->child(high))
+			path.push_back(cur);
+		if (end->getCount() > 1)
+		{
+			end->setCount(end->getCount() - 1);
+			end->update();
+		}
+		else
+		{
+			node<T>* rest = high ? end->left : end->right;
+			(path.empty() ? root
+				: (high ? path.back()->right : path.back()->left)) = rest;
+			node<T>* next = path.empty() ? nullptr : path.back();
+			for (node<T>* cur = rest; cur != nullptr; cur = cur->child(high))
+				next = cur;
+			(high ? m_high : m_low) = next;
+			if ((high ? m_low : m_high) == end)
+				m_low = m_high = nullptr;   // end was the only node
+			delete end;
+		}
+		for (size_t i = path.size(); i-- > 0; )
+		{
+			node<T>*& slot = (i == 0) ? root
+				: (high ? path[i - 1]->right : path[i - 1]->left);
+			slot->update();
+			rebalance(slot);
+		}
+		noteChurn();
+		return contents;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::findEnds()
+	// Title:		Finds the smallest and largest nodes
+	// Description: Walks the left and right spines to refresh the cached
+	//				end nodes after a change that may have moved or
+	//				deleted them.  A subtree of nothing but tombstones
+	//				weighs 0 and is passed over, so the ends are the
+	//				smallest and largest live nodes, still in O(log n).
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		N/A
+	// Called By:	operator=()
+	//				delTree()
+	//				compact()
+	//				unionWith(), intersectWith(), subtract()
+	//				trackGone(), erase()
+	//				bury(), purge()
+	// Parameters:	N/A
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW skips tombstones
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::findEnds()
+	{
+		m_low = m_high = nullptr;
+		if (root == nullptr || root->getWeight() == 0)
+			return;
+		for (int high = 0; high < 2; high++)
+		{
+			node<T>* cur = root;
+			for (;;)
+			{
+				node<T>* outer = cur->child(high != 0);
+				if (outer != nullptr && outer->getWeight() != 0)
+					cur = outer;
+				else if (cur->getCount() != 0)
+					break;
+				else
+					cur = cur->child(high == 0);   // live copies lie inward
+			}
+			(high ? m_high : m_low) = cur;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline bool avl<T, Balance>::bury(const T& d)
+	// Title:		Lazily removes an element
+	// Description: Takes one copy of d off its node's count without
+	//				unlinking anything: a node left with no copies is a
+	//				tombstone that lookups, iteration and size() pass over.
+	//				Only the weights along the search path are refreshed,
+	//				so no rotation runs and the cost is one O(log n)
+	//				descent.  The key is recorded for purge(), which runs
+	//				once more than setLazyErase()'s limit are recorded.
+	//				Burying the last live element frees the whole tree.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		update()
+	//				findEnds()
+	//				delTree()
+	//				purge()
+	// Called By:	bool erase(const T& d)
+	//				popEnd()
+	//				buryFrom()
+	// Parameters:	const T& d; the data to remove
+	// Returns:		true if d was found and removed; false if not
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline bool avl<T, Balance>::bury(const T& d)
+	{
+		vector<node<T>*>& path = m_spine;
+		path.clear();
+		node<T>* cur = root;
+		for (; cur != nullptr && !(d == cur->value());
+			cur = cur->child(cur->value() < d))
+			path.push_back(cur);
+		if (cur == nullptr || cur->getCount() == 0)
+			return false;
+		if (cur->getCount() > 1)
+			cur->setCount(cur->getCount() - 1);
+		else
+		{
+			m_graves.push_back(cur->value());
+			cur->setCount(0);
+			m_tombstones++;
+		}
+		cur->update();
+		for (size_t i = path.size(); i-- > 0; )
+			path[i]->update();
+		if (root->getWeight() == 0)
+			delTree(root);
+		else if (cur == m_low || cur == m_high)
+			findEnds();
+		if (m_graves.size() > m_purgeAfter)
+			purge();
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline T avl<T, Balance>::buryFrom(const node<T>* np,
+	//				int end)
+	// Title:		Pops an element under lazy erase
+	// Description: The pops that take a node would unlink from a subtree
+	//				that may hold tombstones, so under lazy erase they bury
+	//				instead, as popEnd() does.  Finds np's element (end 0),
+	//				or the lowest (end < 0) or highest (end > 0) live
+	//				element below np, passing subtrees of weight 0, and
+	//				buries one copy of it.  O(log n).
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		bury()
+	//				noteChurn()
+	// Called By:	popNode(), popLow(), popHigh()
+	//				popnode(), poplow()
+	// Parameters:	const node<T>* np; the node or subtree to pop from
+	//				int end; 0 for np itself, below 0 for the lowest
+	//				element, above 0 for the highest
+	// Returns:		T contents; the element popped
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline T avl<T, Balance>::buryFrom(const node<T>* np, int end)
+	{
+		while (np != nullptr && end != 0)
+		{
+			const node<T>* outer = np->child(end > 0);
+			if (outer != nullptr && outer->getWeight() != 0)
+				np = outer;
+			else if (np->getCount() != 0)
+				break;
+			else
+				np = np->child(end < 0);
+		}
+		if (np == nullptr || np->getCount() == 0)
+			throw (invalid_argument("Pointer does not point to a node"));
+		T contents = np->value();
+		bury(contents);
+		noteChurn();
+		return contents;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::purge()
+	// Title:		Unlinks every tombstone
+	// Description: Sorts the recorded keys, keeps those whose node is
+	//				still a tombstone (an insert may have revived it),
+	//				builds them into a tree and subtracts it with
+	//				difference(), which splits and rejoins only the
+	//				subtrees that hold a tombstone: O(t log(n/t + 1)) for
+	//				t tombstones, after O(t log n) to check the keys.  The
+	//				batch is rebalanced as it is rejoined.  Runs on its own
+	//				past setLazyErase()'s limit, or whenever called, such
+	//				as at a quiet time.  Invalidates iterators.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		buildBalanced()
+	//				difference()
+	//				forkDepth()
+	//				findEnds()
+	// Called By:	bury()
+	//				setLazyErase()
+	//				unionWith(), intersectWith(), subtract()
+	//				splitAt(), append()
+	//				main()
+	// Parameters:	N/A
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	// Known Bugs:	If building the tree of keys throws, the tombstones
+	//				stay linked and the keys recorded
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::purge()
+	{
+		if (m_tombstones == 0)
+		{
+			m_graves.clear();
+			return;
+		}
+		sort(m_graves.begin(), m_graves.end());
+		m_graves.erase(unique(m_graves.begin(), m_graves.end()),
+			m_graves.end());
+		size_t kept = 0;
+		for (size_t i = 0; i < m_graves.size(); i++)
+		{
+			const T& d = m_graves[i];
+			node<T>* cur = root;
+			while (cur != nullptr && !(d == cur->value()))
+				cur = cur->child(cur->value() < d);
+			if (cur != nullptr && cur->getCount() == 0)
+				m_graves[kept++] = d;
+		}
+		m_graves.resize(kept);
+		node<T>* doomed = buildBalanced(m_graves.data(),
+			m_graves.data() + kept, nullptr);
+		m_graves.clear();
+		node<T>* a = root;
+		root = nullptr;    // detached while the threads work on it
+		root = difference(a, doomed, forkDepth());
+		m_tombstones = 0;
+		findEnds();
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::buildBalanced(const T* first,
+	//				const T* last, const size_t* counts)
+	// Title:		Builds a balanced subtree
+	// Description: Recursively builds a height-balanced subtree from a
+	//				sorted run of unique elements, using the middle element
+	//				as the root of each subtree
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		node<T>; constructor
+	//				buildBalanced(); recursively
+	//				update()
+	// Called By:	bulkInsert()
+	// Parameters:	T* first, last; the sorted elements to build from,
+	//				moved into the nodes
+	//				const size_t* counts; copies of each element, parallel
+	//				to first; nullptr for one copy each
+	// Returns:		node<T>* mid; root of the new subtree, nullptr if empty
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::buildBalanced(T* first, T* last,
+		const size_t* counts)
+	{
+		if (first == last)
+			return nullptr;
+		size_t half = static_cast<size_t>(last - first) / 2;
+		T* middle = first + half;
+		node<T>* mid = new node<T>(std::move(*middle));
+		try
+		{
+			if (counts != nullptr)
+				mid->setCount(counts[half]);
+			mid->left = buildBalanced(first, middle, counts);
+			mid->right = buildBalanced(middle + 1, last,
+				counts ? counts + half + 1 : nullptr);
+		}
+		catch (bad_alloc&)
+		{
+			delTree(mid);
+			throw;
+		}
+		mid->update();
+		return mid;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::attach(
+	//				vector<node<T>*>& path, bool toLeft, T d)
+	// Title:		Hangs a new leaf off a known path
+	// Description: Links a new node holding d as the empty left or right
+	//				child of path.back(), then walks back up the path fixing
+	//				heights and rebalancing, stopping at the first subtree
+	//				whose height did not change; the ancestors above that
+	//				only have their weights recounted.  path is left
+	//				leading to the new node, rebuilt only below that point.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		node<T>; constructor
+	//				update()
+	//				rebalance()
+	// Called By:	insert(iterator hint, T d)
+	// Parameters:	vector<node<T>*>& path; root to the new node's parent;
+	//					on return, root to the new node
+	//				bool toLeft; which empty child slot receives d
+	//				T d; the data to be inserted
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW updates path in place
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::attach(vector<node<T>*>& path, bool toLeft,
+		T d)
+	{
+		node<T>* leaf = new node<T>(std::move(d));
+		(toLeft ? path.back()->left : path.back()->right) = leaf;
+		trackNew(leaf);
+		m_churn++;    // counted only; compacting would void the iterator
+		size_t top = path.size();
+		while (top > 0)
+		{
+			node<T>* cur = path[--top];
+			int before = cur->getHeight();
+			cur->update();
+			node<T>*& slot = (top == 0) ? root
+				: (path[top - 1]->left == cur ? path[top - 1]->left
+					: path[top - 1]->right);
+			rebalance(slot);
+			if (slot->getHeight() == before)
+				break;
+		}
+		for (size_t i = top; i-- > 0; )
+			path[i]->update();
+		// nodes above path[top] did not move; find d again below it
+		path.resize(top);
+		node<T>* cur = (top == 0) ? root
+			: (d < path[top - 1]->value() ? path[top - 1]->left
+				: path[top - 1]->right);
+		while (cur != leaf)
+		{
+			path.push_back(cur);
+			cur = cur->child(cur->value() < d);
+		}
+		path.push_back(leaf);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::join(node<T>* left,
+	//				node<T>* middle, node<T>* right)
+	// Title:		Joins two trees through a middle node
+	// Description: Links two avl trees, every element of left below
+	//				middle's and every element of right above it, into one
+	//				avl tree.  Walks down the spine of the taller tree to a
+	//				subtree whose height is within the Balance policy's
+	//				slack of the shorter tree, hangs both off middle there,
+	//				and rebalances on the way back up.  O(difference in
+	//				heights).
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		join(); recursively
+	//				update()
+	//				rebalance()
+	// Called By:	split()
+	//				unite()
+	//				intersect()
+	//				difference()
+	// Parameters:	node<T>* left, right; the trees to join, either empty
+	//				node<T>* middle; a detached node between them
+	// Returns:		node<T>*; root of the joined tree
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::join(node<T>* left, node<T>* middle,
+		node<T>* right)
+	{
+		int leftHeight = left ? left->getHeight() : 0;
+		int rightHeight = right ? right->getHeight() : 0;
+		if (leftHeight - rightHeight > Balance::slack)
+		{
+			left->right = join(left->right, middle, right);
+			left->update();
+			return rebalance(left);
+		}
+		if (rightHeight - leftHeight > Balance::slack)
+		{
+			right->left = join(left, middle, right->left);
+			right->update();
+			return rebalance(right);
+		}
+		middle->left = left;
+		middle->right = right;
+		middle->update();
+		return middle;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::join(node<T>* left,
+	//				node<T>* right)
+	// Title:		Joins two trees
+	// Description: Links two avl trees, every element of left below every
+	//				element of right, using left's largest node as the
+	//				middle.  O(log n).
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		splitLast()
+	//				join(left, middle, right)
+	// Called By:	intersect()
+	//				difference()
+	//				extract()
+	// Parameters:	node<T>* left, right; the trees to join, either empty
+	// Returns:		node<T>*; root of the joined tree
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::join(node<T>* left, node<T>* right)
+	{
+		if (left == nullptr)
+			return right;
+		node<T>* middle;
+		left = splitLast(left, middle);
+		return join(left, middle, right);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::splitLast(node<T>* np,
+	//				node<T>*& last)
+	// Title:		Unlinks the largest node
+	// Description: Removes the rightmost node from the subtree at np,
+	//				rebalancing on the way back up, and hands it back
+	//				detached
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		splitLast(); recursively
+	//				update()
+	//				rebalance()
+	// Called By:	join(left, right)
+	// Parameters:	node<T>* np; a non-empty subtree
+	//				node<T>*& last; receives the detached node
+	// Returns:		node<T>*; root of what is left of the subtree
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::splitLast(node<T>* np, node<T>*& last)
+	{
+		if (np->right == nullptr)
+		{
+			node<T>* rest = np->left;
+			np->left = nullptr;
+			np->update();
+			last = np;
+			return rest;
+		}
+		np->right = splitLast(np->right, last);
+		np->update();
+		return rebalance(np);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::split(node<T>* np, const T& d,
+	//				node<T>*& left, node<T>*& match, node<T>*& right)
+	// Title:		Splits a tree at an element
+	// Description: Cuts the subtree at np into an avl tree of the elements
+	//				below d and one of the elements above it, joining the
+	//				pieces hanging off the search path for d.  The node
+	//				holding d, if any, is handed back detached.  O(log n).
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split(); recursively
+	//				join()
+	//				update()
+	// Called By:	unite()
+	//				intersect()
+	//				difference()
+	//				extract()
+	// Parameters:	node<T>* np; the subtree to split; consumed
+	//				const T& d; the element to split at
+	//				node<T>*& left; receives the elements below d
+	//				node<T>*& match; receives the node holding d, or
+	//				nullptr
+	//				node<T>*& right; receives the elements above d
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::split(node<T>* np, const T& d, node<T>*& left,
+		node<T>*& match, node<T>*& right)
+	{
+		if (np == nullptr)
+		{
+			left = match = right = nullptr;
+			return;
+		}
+		node<T>* below = np->left;
+		node<T>* above = np->right;
+		np->left = np->right = nullptr;
+		if (d == np->value())
+		{
+			np->update();
+			left = below;
+			match = np;
+			right = above;
+		}
+		else if (d < np->value())
+		{
+			node<T>* inside;
+			split(below, d, left, match, inside);
+			right = join(inside, np, above);
+		}
+		else
+		{
+			node<T>* inside;
+			split(above, d, inside, match, right);
+			left = join(below, np, inside);
+		}
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline int avl<T, Balance>::forkDepth()
+	// Title:		How deep set operations may fork
+	// Description: The number of levels of recursion at which a set
+	//				operation may hand one half to another thread; enough
+	//				to give every hardware thread some work
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		thread::hardware_concurrency()
+	// Called By:	unionWith()
+	//				intersectWith()
+	//				subtract()
+	// Parameters:	N/A
+	// Returns:		int forks; 0 on a single core
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline int avl<T, Balance>::forkDepth()
+	{
+		unsigned cores = thread::hardware_concurrency();
+		int forks = 0;
+		while (cores > 1)
+		{
+			cores = (cores + 1) / 2;
+			forks++;
+		}
+		return (forks > 0) ? forks + 1 : 0;
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::freeTree(node<T>* np)
+	// Title:		Deletes a detached subtree
+	// Description: Deletes every node below and including np without
+	//				looking at the tree it came from, so the set
+	//				operations can call it from any thread
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		N/A
+	// Called By:	intersect()
+	//				difference()
+	// Parameters:	node<T>* np; the subtree to delete, may be empty
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::freeTree(node<T>* np)
+	{
+		vector<node<T>*> pending;
+		if (np != nullptr)
+			pending.push_back(np);
+		while (!pending.empty())
+		{
+			node<T>* doomed = pending.back();
+			pending.pop_back();
+			if (doomed->left != nullptr)
+				pending.push_back(doomed->left);
+			if (doomed->right != nullptr)
+				pending.push_back(doomed->right);
+			delete doomed;
+		}
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline void avl<T, Balance>::countOnce(node<T>* np)
+	// Title:		Drops duplicate counts from a subtree
+	// Description: Sets the count of every node below and including np
+	//				to 1 and recounts the weights, children before their
+	//				parents, without recursion.  A set calls it on a
+	//				multiset's nodes before taking them.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		update()
+	// Called By:	unionWith()
+	//				append()
+	// Parameters:	node<T>* np; the subtree to change, may be empty
+	// Returns:		N/A
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline void avl<T, Balance>::countOnce(node<T>* np)
+	{
+		vector<node<T>*> order;    // parents before their children
+		if (np != nullptr)
+			order.push_back(np);
+		for (size_t i = 0; i < order.size(); i++)
+		{
+			order[i]->setCount(1);
+			if (order[i]->left != nullptr)
+				order.push_back(order[i]->left);
+			if (order[i]->right != nullptr)
+				order.push_back(order[i]->right);
+		}
+		for (size_t i = order.size(); i-- > 0; )
+			order[i]->update();
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::unite(node<T>* a, node<T>* b,
+	//				int forks)
+	// Title:		Union of two detached subtrees
+	// Description: Splits b at a's root, merges the two left parts and the
+	//				two right parts, and joins the results through a's
+	//				root.  While forks remain and the subtrees are large
+	//				the left parts are merged on another thread.  Both
+	//				subtrees are consumed.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split()
+	//				unite(); recursively
+	//				join()
+	//				async()
+	// Called By:	unionWith()
+	// Parameters:	node<T>* a, b; the subtrees to merge, either empty
+	//				int forks; levels left at which to fork a thread
+	// Returns:		node<T>*; root of the union
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::unite(node<T>* a, node<T>* b, int forks)
+	{
+		if (a == nullptr)
+			return b;
+		if (b == nullptr)
+			return a;
+		node<T> *bLeft, *match, *bRight;
+		split(b, a->value(), bLeft, match, bRight);
+		node<T>* aLeft = a->left;
+		node<T>* aRight = a->right;
+		a->left = a->right = nullptr;
+		if (match != nullptr)
+		{
+			a->setCount(m_multiset ? a->getCount() + match->getCount() : 1);
+			delete match;
+		}
+		node<T> *left, *right;
+		if (forks > 0 && a->getWeight() + (bLeft ? bLeft->getWeight() : 0)
+			+ (bRight ? bRight->getWeight() : 0) > SPLIT_GRAIN)
+		{
+			future<node<T>*> leftHalf = async(launch::async | launch::deferred,
+				[=]() {return unite(aLeft, bLeft, forks - 1);});
+			right = unite(aRight, bRight, forks - 1);
+			left = leftHalf.get();
+		}
+		else
+		{
+			left = unite(aLeft, bLeft, 0);
+			right = unite(aRight, bRight, 0);
+		}
+		return join(left, a, right);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::intersect(node<T>* a,
+	//				node<T>* b, int forks)
+	// Title:		Intersection of two detached subtrees
+	// Description: Splits b at a's root, intersects the two left parts and
+	//				the two right parts, and joins the results, through
+	//				a's root if b held it too.  Nodes not kept are
+	//				deleted.  Forks as unite() does.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split()
+	//				intersect(); recursively
+	//				join()
+	//				freeTree()
+	//				async()
+	// Called By:	intersectWith()
+	// Parameters:	node<T>* a, b; the subtrees to intersect, either empty
+	//				int forks; levels left at which to fork a thread
+	// Returns:		node<T>*; root of the intersection
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::intersect(node<T>* a, node<T>* b, int forks)
+	{
+		if (a == nullptr || b == nullptr)
+		{
+			freeTree(a);
+			freeTree(b);
+			return nullptr;
+		}
+		node<T> *bLeft, *match, *bRight;
+		split(b, a->value(), bLeft, match, bRight);
+		node<T>* aLeft = a->left;
+		node<T>* aRight = a->right;
+		a->left = a->right = nullptr;
+		node<T> *left, *right;
+		if (forks > 0 && a->getWeight() + (bLeft ? bLeft->getWeight() : 0)
+			+ (bRight ? bRight->getWeight() : 0) > SPLIT_GRAIN)
+		{
+			future<node<T>*> leftHalf = async(launch::async | launch::deferred,
+				[=]() {return intersect(aLeft, bLeft, forks - 1);});
+			right = intersect(aRight, bRight, forks - 1);
+			left = leftHalf.get();
+		}
+		else
+		{
+			left = intersect(aLeft, bLeft, 0);
+			right = intersect(aRight, bRight, 0);
+		}
+		if (match == nullptr)
+		{
+			delete a;
+			return join(left, right);
+		}
+		if (match->getCount() < a->getCount())
+			a->setCount(match->getCount());
+		delete match;
+		return join(left, a, right);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::difference(node<T>* a,
+	//				node<T>* b, int forks)
+	// Title:		Difference of two detached subtrees
+	// Description: Splits a at b's root, takes b's left part from a's left
+	//				part and b's right part from a's right part, and joins
+	//				the results, through a's node for b's root element if
+	//				any of its count is left.  Nodes not kept are deleted.
+	//				Forks as unite() does.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split()
+	//				difference(); recursively
+	//				join()
+	//				freeTree()
+	//				async()
+	// Called By:	subtract()
+	// Parameters:	node<T>* a; the subtree to take elements from
+	//				node<T>* b; the elements to take away
+	//				int forks; levels left at which to fork a thread
+	// Returns:		node<T>*; root of the difference
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::difference(node<T>* a, node<T>* b, int forks)
+	{
+		if (a == nullptr || b == nullptr)
+		{
+			freeTree(b);
+			return a;
+		}
+		node<T> *aLeft, *match, *aRight;
+		split(a, b->value(), aLeft, match, aRight);
+		node<T>* bLeft = b->left;
+		node<T>* bRight = b->right;
+		b->left = b->right = nullptr;
+		node<T> *left, *right;
+		if (forks > 0 && b->getWeight() + (aLeft ? aLeft->getWeight() : 0)
+			+ (aRight ? aRight->getWeight() : 0) > SPLIT_GRAIN)
+		{
+			future<node<T>*> leftHalf = async(launch::async | launch::deferred,
+				[=]() {return difference(aLeft, bLeft, forks - 1);});
+			right = difference(aRight, bRight, forks - 1);
+			left = leftHalf.get();
+		}
+		else
+		{
+			left = difference(aLeft, bLeft, 0);
+			right = difference(aRight, bRight, 0);
+		}
+		if (match != nullptr && m_multiset
+			&& b->getCount() < match->getCount())
+		{
+			match->setCount(match->getCount() - b->getCount());
+			delete b;
+			return join(left, match, right);
+		}
+		delete match;
+		delete b;
+		return join(left, right);
+	}
+
+	//------------------------------------------------------------------------
+	// Class:		avl.h
+	// Function:	template<class T, class Balance>
+	//				inline node<T>* avl<T, Balance>::extract(node<T>* np,
+	//				const T* first, const T* last, node<T>*& taken)
+	// Title:		Unlinks a batch of elements from a detached subtree
+	// Description: Splits np at the middle element of [first, last),
+	//				extracts the lower half of the batch from the part
+	//				below and the upper half from the part above, then
+	//				joins the kept parts into one tree and the unlinked
+	//				parts, through the middle element's node if np held
+	//				it, into another.  difference() with a sorted array in
+	//				place of a tree; no node is deleted.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// Input:		N/A
+	// Output:		N/A
+	// Calls:		split()
+	//				extract(); recursively
+	//				join()
+	// Called By:	extract(first, last, taken)
+	// Parameters:	node<T>* np; the subtree to take elements from
+	//				const T* first, last; the elements to take, ascending
+	//				node<T>*& taken; receives the root of the nodes taken
+	// Returns:		node<T>*; root of the nodes kept
+	// History Log: 10-19-26 AW Completed v 1.0
+	//------------------------------------------------------------------------
+	template<class T, class Balance>
+	inline node<T>* avl<T, Balance>::extract(node<T>* np, const T* first,
+		const T* last, node<T>*& taken)
+	{
+		if (np == nullptr || first == last)
+		{
+			taken = nullptr;
+			return np;
+		}
+		const T* middle = first + (last - first) / 2;
+		node<T> *below, *match, *above;
+		split(np, *middle, below, match, above);
+		node<T> *takenBelow, *takenAbove;
+		below = extract(below, first, middle, takenBelow);
+		above = extract(above, middle + 1, last, takenAbove);
+		taken = match ? join(takenBelow, match, takenAbove)
+			: join(takenBelow, takenAbove);
+		return join(below, above);
+	}
 }
 #endif
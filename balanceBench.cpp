@@ -0,0 +1,148 @@
+//----------------------------------------------------------------------------
+// File:		balanceBench.cpp
+//
+// Description: Benchmark of the avl<T> balancing policies heightBalance<1>
+//				(strict AVL), <2> and <3>: rotations per operation, insert,
+//				churn and lookup times, height and mean node depth
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				depthSum()
+//				runPolicy()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <random>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	depthSum()
+	// Title:		Sums node depths
+	// Description: Adds up the depth of every node below cur, counting the
+	//				root as depth 1, which is the number of nodes a
+	//				successful find() visits
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		depthSum(); recursively
+	// Called By:	runPolicy()
+	// Parameters:	const node<int>* cur; subtree to sum
+	//				int depth; depth of cur
+	// Returns:		the sum of the depths
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double depthSum(const AW_BST::node<int>* cur, int depth)
+	{
+		if(cur == nullptr)
+			return 0;
+		return depth + depthSum(cur->left, depth + 1)
+			+ depthSum(cur->right, depth + 1);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	runPolicy()
+	// Title:		Times one balancing policy
+	// Description: Inserts n random keys, then runs 2n operations
+	//				alternating inserts and erases, then 2n lookups, and
+	//				prints one row: seconds and single rotations per
+	//				operation for each phase, the height and the mean node
+	//				depth
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int, Balance>::insert(), erase(), find(),
+	//				rotations(), getHeight(), size(), depthSum()
+	// Called By:	main()
+	// Parameters:	const char* name; label for the row
+	//				int n; keys to insert, drawn from [0, 2n)
+	// Returns:		void
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	template <class Balance>
+	void runPolicy(const char* name, int n)
+	{
+		AW_BST::avl<int, Balance> tree;
+		mt19937 rng(7);
+		int range = 2 * n;
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(int i = 0; i < n; i++)
+			tree.insert(static_cast<int>(rng() % range));
+		double insertTime = AW_BST::secondsSince(start);
+		size_t insertRotations = tree.rotations();
+
+		start = chrono::steady_clock::now();
+		for(int i = 0; i < 2 * n; i++)
+		{
+			int k = static_cast<int>(rng() % range);
+			if(i % 2 == 1)
+				tree.insert(k);
+			else
+				tree.erase(k);
+		}
+		double churnTime = AW_BST::secondsSince(start);
+		size_t churnRotations = tree.rotations() - insertRotations;
+
+		start = chrono::steady_clock::now();
+		long hits = 0;
+		for(int i = 0; i < 2 * n; i++)
+			hits += (tree.find(static_cast<int>(rng() % range)) != nullptr);
+		double lookupTime = AW_BST::secondsSince(start);
+		AW_BST::keepResult(hits);
+
+		cout << setw(8) << name << setprecision(3)
+			<< setw(9) << insertTime
+			<< setw(9) << static_cast<double>(insertRotations) / n
+			<< setw(9) << churnTime
+			<< setw(9) << static_cast<double>(churnRotations) / (2 * n)
+			<< setw(9) << lookupTime
+			<< setw(8) << tree.getHeight() << setprecision(2)
+			<< setw(8) << depthSum(tree.getroot(), 1) / tree.size() << endl;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		Balancing policy benchmark
+// Description: Runs runPolicy() for heightBalance<1>, <2> and <3>
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: keys to insert (default 200000)
+// Output:		one row per policy
+// Calls:		runPolicy()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 200000;
+	cout << n << " random inserts, " << 2 * n << " alternating inserts and "
+		<< "erases, " << 2 * n << " lookups" << endl;
+	cout << "  slack   insert  rot/ins    churn   rot/op   lookup  height"
+		<< "   depth" << endl;
+	cout << fixed;
+	runPolicy<AW_BST::heightBalance<1>>("1", n);
+	runPolicy<AW_BST::heightBalance<2>>("2", n);
+	runPolicy<AW_BST::heightBalance<3>>("3", n);
+	return EXIT_SUCCESS;
+}
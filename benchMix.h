@@ -0,0 +1,95 @@
+#ifndef BENCHMIX_H
+#define BENCHMIX_H
+//--------------------------------------------------------------------
+// Shared pieces of the standalone *Bench.cpp programs
+//--------------------------------------------------------------------
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// seconds elapsed since start, by the steady clock
+	//--------------------------------------------------------------------
+	inline double secondsSince(chrono::steady_clock::time_point start)
+	{
+		return chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+	}
+
+	//--------------------------------------------------------------------
+	// stores a result where the optimizer must assume it is read, so
+	// the work that produced it is not dropped
+	//--------------------------------------------------------------------
+	template <class V>
+	inline void keepResult(const V& v)
+	{
+		static atomic<V> sink;
+		sink.store(v, memory_order_relaxed);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	runMix()
+	// Title:		Times one mixed workload
+	// Description: Fills set with every other key in [0, range), then has
+	//				threads threads each run ops operations on uniform
+	//				random keys: readPercent% lookups, the rest split
+	//				evenly between inserts and erases
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		set.insert(), set.erase(), set.contains()
+	// Called By:	concurrentBench main(), shardedBench main()
+	// Parameters:	Set& set; the set to run on, empty
+	//				int threads; worker threads
+	//				long ops; operations per thread
+	//				int range; keys are drawn from [0, range)
+	//				int readPercent; share of lookups, 0 to 100
+	// Returns:		operations per second, all threads together
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW moved here from concurrentBench.cpp; the
+	//					read share is a parameter
+	//---------------------------------------------------------------------------
+	template <class Set>
+	double runMix(Set& set, int threads, long ops, int range,
+		int readPercent = 80)
+	{
+		for(int k = 0; k < range; k += 2)
+			set.insert(k);
+		int writePercent = 100 - readPercent;
+		vector<thread> workers;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(int t = 0; t < threads; t++)
+		{
+			workers.push_back(thread([&set, t, ops, range, writePercent]()
+			{
+				mt19937 rng(static_cast<unsigned>(t) + 1);
+				long hits = 0;
+				for(long i = 0; i < ops; i++)
+				{
+					int k = static_cast<int>(rng() % range);
+					int op = static_cast<int>(rng() % 200);
+					if(op < writePercent)
+						set.insert(k);
+					else if(op < 2 * writePercent)
+						set.erase(k);
+					else
+						hits += set.contains(k);
+				}
+				keepResult(hits);
+			}));
+		}
+		for(size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+		return threads * static_cast<double>(ops) / secondsSince(start);
+	}
+
+} // end namespace AW_BST
+
+#endif
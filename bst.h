@@ -3,7 +3,7 @@
 //--------------------------------------------------------------------
 // A rudimentary Binary Search Tree program
 // Compiled under MS Visual C++.Net 2005, 2010, 2013
-// allows duplicates
+// allows duplicates (counted in place when built as a multiset)
 // by Paul Bladek
 // December, 2000
 // revised April, 2005
@@ -14,41 +14,251 @@
 
 #include <iostream>
 #include <iomanip>
+#include <locale>
 #include <exception>
 #include <stdexcept>
 #include <vector>
 #include <cmath>
 #include <string>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <sstream>
+#include <utility>
+#include <type_traits>
+#include <limits>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <atomic>
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <xmmintrin.h>
+#endif
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// gcc matches an inlined class operator new's ::operator new against
+// the class operator delete and warns; out of line, the pair matches
+#if defined(__GNUC__)
+#define AW_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define AW_NOINLINE __declspec(noinline)
+#else
+#define AW_NOINLINE
+#endif
 
 using namespace std;
 
 namespace AW_BST
 {
+	//--------------------------------------------------------------------
+	// true for keys that are cheaper to copy than to reach through a
+	// reference: trivially copyable and no wider than a pointer
+	//--------------------------------------------------------------------
+	template <class T>
+	struct isSmallKey
+	{
+		static const bool value = is_trivially_copyable<T>::value
+			&& sizeof(T) <= sizeof(void*);
+	};
+
+	//--------------------------------------------------------------------
+	// asks the cache to start loading *p; a hint only, p may be nullptr
+	//--------------------------------------------------------------------
+	inline void prefetchNode(const void* p)
+	{
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+		_mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#elif defined(__GNUC__)
+		__builtin_prefetch(p);
+#else
+		(void)p;
+#endif
+	}
+
+	const size_t FIND_GROUP = 16;   // lookups findMany() runs side by side
+
+	//--------------------------------------------------------------------
+	// NODE BLOCKS
+	// aligned chunks holding many nodes side by side (see
+	// avl<T>::compact()).  Such nodes are still deleted one at a time;
+	// node<T>'s operator delete hands them here, and a chunk is freed
+	// with its last node.  operator new always returns memory aligned
+	// for max_align_t, while every slot in a chunk sits TAG bytes off
+	// that alignment, so a node's address alone says where it came
+	// from, and masking it finds its chunk's header: no lock, no lookup.
+	//--------------------------------------------------------------------
+	class nodeBlocks
+	{
+	public:
+		static const size_t TAG = alignof(max_align_t) / 2;
+
+		static bool holds(const void* p)
+			{return (reinterpret_cast<uintptr_t>(p) & TAG) != 0;}
+		static size_t stride(size_t nodeBytes)    // keeps slots TAG off
+			{return (nodeBytes + 2 * TAG - 1) / (2 * TAG) * (2 * TAG);}
+		static size_t chunkBytes(size_t nodeBytes);
+		static void allocate(size_t nodeBytes, size_t nodes,
+			vector<void*>& slots);
+		static void release(void* p, size_t nodeBytes);
+	private:
+		static const size_t MIN_CHUNK = 64 << 10;
+		static const size_t MIN_SLOTS = 64;      // per chunk
+		struct header
+		{
+			atomic<size_t> live;    // slots not yet released
+		};
+		static size_t firstSlot()
+			{return stride(sizeof(header)) + TAG;}
+		static void* allocateChunk(size_t bytes);
+		static void freeChunk(void* chunk);
+	};
+
+	//--------------------------------------------------------------------
+	// the power of two chunk size for nodes of nodeBytes: 64K, or more
+	// if that would hold fewer than MIN_SLOTS of them
+	//--------------------------------------------------------------------
+	inline size_t nodeBlocks::chunkBytes(size_t nodeBytes)
+	{
+		size_t bytes = MIN_CHUNK;
+		while(bytes < firstSlot() + MIN_SLOTS * stride(nodeBytes))
+			bytes *= 2;
+		return bytes;
+	}
+
+	//--------------------------------------------------------------------
+	// appends the addresses of nodes slots, in order, packed into as few
+	// chunks as will hold them; each slot must later be handed to
+	// release(), directly or by deleting the node built there
+	// throws bad_alloc, having freed any chunks it took
+	//--------------------------------------------------------------------
+	inline void nodeBlocks::allocate(size_t nodeBytes, size_t nodes,
+		vector<void*>& slots)
+	{
+		size_t bytes = chunkBytes(nodeBytes);
+		size_t step = stride(nodeBytes);
+		size_t perChunk = (bytes - firstSlot()) / step;
+		size_t start = slots.size();
+		slots.reserve(start + nodes);
+		try
+		{
+			while(nodes > 0)
+			{
+				size_t here = (nodes < perChunk) ? nodes : perChunk;
+				char* chunk = static_cast<char*>(allocateChunk(bytes));
+				::new (chunk) header();
+				reinterpret_cast<header*>(chunk)->live.store(here);
+				for(size_t i = 0; i < here; i++)
+					slots.push_back(chunk + firstSlot() + i * step);
+				nodes -= here;
+			}
+		}
+		catch(...)
+		{
+			for(size_t i = start; i < slots.size(); i++)
+				release(slots[i], nodeBytes);
+			slots.resize(start);
+			throw;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// counts the slot at p gone, and frees its chunk if that was the last
+	// pre: holds(p)
+	//--------------------------------------------------------------------
+	inline void nodeBlocks::release(void* p, size_t nodeBytes)
+	{
+		uintptr_t at = reinterpret_cast<uintptr_t>(p);
+		header* chunk = reinterpret_cast<header*>(
+			at & ~static_cast<uintptr_t>(chunkBytes(nodeBytes) - 1));
+		if(chunk->live.fetch_sub(1) == 1)
+		{
+			chunk->~header();
+			freeChunk(chunk);
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// memory for one chunk, aligned to its own size
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline void* nodeBlocks::allocateChunk(size_t bytes)
+	{
+#ifdef _WIN32
+		void* chunk = _aligned_malloc(bytes, bytes);
+#else
+		void* chunk = nullptr;
+		if(posix_memalign(&chunk, bytes, bytes) != 0)
+			chunk = nullptr;
+#endif
+		if(chunk == nullptr)
+			throw bad_alloc();
+		return chunk;
+	}
+
+	inline void nodeBlocks::freeChunk(void* chunk)
+	{
+#ifdef _WIN32
+		_aligned_free(chunk);
+#else
+		free(chunk);
+#endif
+	}
+
 	// CLASS DEFINITIONS 
 	template<class T>
 	//--------------------------------------------------------------------
 	// BST NODE
 	// REQUIRES Type T be able to convert from int & have < & == defined
+	// small keys are handed out by value and packed with 32-bit counts
+	// (an int node is 32 bytes); anything else is handed out by const
+	// reference so a descent never copies a key
 	//--------------------------------------------------------------------
 	class node
 	{
 	public: 
-		node(T d = 1) : m_data(d), m_height(1), left(nullptr),
-			right(nullptr){}
+		typedef typename conditional<isSmallKey<T>::value, T,
+			const T&>::type valueType;
+		typedef typename conditional<isSmallKey<T>::value, uint32_t,
+			size_t>::type countType;
+		static const size_t MAX_WEIGHT =
+			static_cast<size_t>(numeric_limits<countType>::max());
+
+		node(T d = 1) : m_data(std::move(d)), m_height(1), m_count(1), m_weight(1),
+			left(nullptr), right(nullptr){}
 		node(const node<T>& n); // Copy Constructor
 		node<T>& operator=(const node<T>& n);
-		T value() const {return m_data;}    // Accessor
+		valueType value() const {return m_data;}    // Accessor
 		operator T() const {return m_data;}  // cast to data type
-		void setdata(T d) {m_data = d;}
+		void setdata(T d) {m_data = std::move(d);}
 		int getHeight() const {return m_height;}
 		int setHeight();
+		int update();
+		size_t getCount() const {return m_count;}     // copies of m_data
+		void setCount(size_t c) {m_count = static_cast<countType>(c);}
+		size_t getWeight() const {return m_weight;}   // copies in subtree
+		node<T>* child(bool goRight) const   // branch-free left/right pick
+			{node<T>* const children[2] = {left, right};
+			return children[goRight];}
+		static AW_NOINLINE void* operator new(size_t bytes)
+			{return ::operator new(bytes);}
+		static void operator delete(void* p)
+			{if(nodeBlocks::holds(p))
+				nodeBlocks::release(p, sizeof(node<T>));
+			else ::operator delete(p);}
 	private: 
 		T m_data;
 		int m_height;
+		countType m_count;
+		countType m_weight;
 	public:  // to freely use these
 		node<T>* left;
 		node<T>* right;
 	}; 
+
+	template <class T>
+	const size_t node<T>::MAX_WEIGHT;
 	
 	//--------------------------------------------------------------------
 	// COPY CONSTRUCTOR
@@ -56,8 +266,8 @@ namespace AW_BST
 	//--------------------------------------------------------------------
 	template <class T>
 	node<T>::node(const node<T>& n)
-		: m_data(n.m_data), m_height(n.getHeight()), left(nullptr),
-			right(nullptr)	
+		: m_data(n.m_data), m_height(n.getHeight()), m_count(n.m_count),
+			m_weight(n.m_weight), left(nullptr), right(nullptr)	
 	{
 		if(n.left != nullptr)
 			left = new node<T>(*(n.left));
@@ -76,6 +286,8 @@ namespace AW_BST
 	   {
 		m_data = n.m_data;
 		m_height = n.getHeight();
+		m_count = n.m_count;
+		m_weight = n.m_weight;
 		if(n.left != nullptr)
 			left = new node<T>(*(n.left));
 		else
@@ -90,7 +302,18 @@ namespace AW_BST
 
 	
 	//--------------------------------------------------------------------
-	// recursively sets the Height of the node
+	// refreshes any subtree summary a key type keeps inside itself from
+	// the node's children; called wherever heights are recomputed, so
+	// the summary survives inserts, erases and rotations.  Key types
+	// that carry one overload augment() in their own namespace.  A
+	// tombstone left by avl's lazy erase still counts in the summary,
+	// so trees that keep one leave lazy erase off.
+	//--------------------------------------------------------------------
+	template <class T>
+	inline void augment(T&, const node<T>*, const node<T>*) {}
+
+	//--------------------------------------------------------------------
+	// recursively sets the Height (and weight) of the node
 	//--------------------------------------------------------------------
 	template <class T>
 	int node<T>::setHeight()
@@ -98,14 +321,344 @@ namespace AW_BST
 		int lHeight = 0;
 		int rHeight = 0;
 		m_height = 1;
+		m_weight = m_count;
 
 		if(left != nullptr)	
+		{
 			lHeight = left->setHeight();
+			m_weight += left->m_weight;
+		}
 		if(right != nullptr)
+		{
 			rHeight = right->setHeight();
+			m_weight += right->m_weight;
+		}
+		augment(m_data, left, right);
 		return (m_height += (lHeight > rHeight) ? lHeight : rHeight);
 	}
 
+	//--------------------------------------------------------------------
+	// sets the Height and weight of the node from those of its children
+	// non-recursive: children must already hold correct values
+	//--------------------------------------------------------------------
+	template <class T>
+	int node<T>::update()
+	{
+		int lHeight = 0;
+		int rHeight = 0;
+		m_weight = m_count;
+		if(left != nullptr)
+		{
+			lHeight = left->m_height;
+			m_weight += left->m_weight;
+		}
+		if(right != nullptr)
+		{
+			rHeight = right->m_height;
+			m_weight += right->m_weight;
+		}
+		augment(m_data, left, right);
+		return (m_height = 1 + ((lHeight > rHeight) ? lHeight : rHeight));
+	}
+
+	//--------------------------------------------------------------------
+	// writes text as a double-quoted, backslash-escaped string
+	// (valid in both JSON and Graphviz DOT)
+	//--------------------------------------------------------------------
+	inline void writeQuoted(ostream& out, const string& text)
+	{
+		const char* HEX = "0123456789abcdef";
+		out << '"';
+		for(size_t i = 0; i < text.size(); i++)
+		{
+			unsigned char c = static_cast<unsigned char>(text[i]);
+			if(c == '"' || c == '\\')
+				out << '\\' << text[i];
+			else if(c < 0x20)
+				out << "\\u00" << HEX[c >> 4] << HEX[c & 0xF];
+			else
+				out << text[i];
+		}
+		out << '"';
+	}
+
+	//--------------------------------------------------------------------
+	// writes a value as JSON: numbers bare, anything else as a string
+	//--------------------------------------------------------------------
+	template <class T>
+	typename enable_if<is_arithmetic<T>::value && !is_same<T, char>::value
+		&& !is_same<T, bool>::value>::type
+	writeJSONValue(ostream& out, const T& d)
+	{
+		out << +d;
+	}
+
+	template <class T>
+	typename enable_if<!is_arithmetic<T>::value || is_same<T, char>::value
+		|| is_same<T, bool>::value>::type
+	writeJSONValue(ostream& out, const T& d)
+	{
+		ostringstream text;
+		text << d;
+		writeQuoted(out, text.str());
+	}
+
+	//--------------------------------------------------------------------
+	// Buffered Stream Writer
+	// collects output in a fixed buffer and hands it to the stream in
+	// large writes; arithmetic values are formatted by hand instead of
+	// going through ostream's per-call locale and sentry machinery.
+	// That matches operator<< only on a plain stream: default flags, no
+	// width and the classic locale.  On any other stream the writeValue
+	// overloads go through operator<< instead, so hex, showpos, fixed, a
+	// width or a grouping locale still apply.
+	//--------------------------------------------------------------------
+	class streamWriter
+	{
+	public:
+		explicit streamWriter(ostream& out) : m_out(out), m_used(0),
+			m_plain(out.flags() == (ios_base::skipws | ios_base::dec)
+				&& out.width() == 0 && out.getloc() == locale::classic()) {}
+		~streamWriter() {flush();}
+		bool plain() const {return m_plain;}   // formats by hand
+		void put(char c)
+			{if(m_used == BUFFER_SIZE) flush(); m_buf[m_used++] = c;}
+		void put(const char* text, size_t length);
+		void put(const char* text) {put(text, strlen(text));}
+		void putInteger(unsigned long long d, bool negative = false);
+		void putFloat(double d);
+		void flush();
+		ostream& stream() {flush(); return m_out;}
+	private:
+		streamWriter(const streamWriter&);            // not copyable
+		streamWriter& operator=(const streamWriter&);
+		static const size_t BUFFER_SIZE = 4096;
+		ostream& m_out;
+		size_t m_used;
+		bool m_plain;     // the stream formats as the hand-written code does
+		char m_buf[BUFFER_SIZE];
+	};
+
+	//--------------------------------------------------------------------
+	// hands everything buffered so far to the stream
+	//--------------------------------------------------------------------
+	inline void streamWriter::flush()
+	{
+		if(m_used != 0)
+			m_out.write(m_buf, static_cast<streamsize>(m_used));
+		m_used = 0;
+	}
+
+	//--------------------------------------------------------------------
+	// appends length bytes of text; long runs go straight to the stream
+	//--------------------------------------------------------------------
+	inline void streamWriter::put(const char* text, size_t length)
+	{
+		if(length > BUFFER_SIZE - m_used)
+		{
+			flush();
+			if(length > BUFFER_SIZE)
+			{
+				m_out.write(text, static_cast<streamsize>(length));
+				return;
+			}
+		}
+		memcpy(m_buf + m_used, text, length);
+		m_used += length;
+	}
+
+	//--------------------------------------------------------------------
+	// appends the decimal digits of d, with a leading '-' if negative
+	//--------------------------------------------------------------------
+	inline void streamWriter::putInteger(unsigned long long d, bool negative)
+	{
+		char digits[24];
+		char* first = digits + sizeof(digits);
+		do
+		{
+			*--first = static_cast<char>('0' + d % 10);
+			d /= 10;
+		}
+		while(d != 0);
+		if(negative)
+			*--first = '-';
+		put(first, static_cast<size_t>(digits + sizeof(digits) - first));
+	}
+
+	//--------------------------------------------------------------------
+	// appends d as ostream would with default flags (%g at the
+	// stream's precision)
+	//--------------------------------------------------------------------
+	inline void streamWriter::putFloat(double d)
+	{
+		char digits[64];
+		int length = snprintf(digits, sizeof(digits), "%.*g",
+			static_cast<int>(m_out.precision()), d);
+		if(length > 0)
+			put(digits, static_cast<size_t>(length) < sizeof(digits)
+				? static_cast<size_t>(length) : sizeof(digits) - 1);
+	}
+
+	//--------------------------------------------------------------------
+	// writeValue overloads -- append one element through a streamWriter
+	// types without an overload, and every type on a stream that is not
+	// plain, fall back to their own operator<<
+	//--------------------------------------------------------------------
+	template <class T>
+	struct isCharacter
+	{
+		static const bool value = is_same<T, char>::value
+			|| is_same<T, signed char>::value
+			|| is_same<T, unsigned char>::value;
+	};
+
+	template <class T>
+	typename enable_if<isCharacter<T>::value>::type
+	writeValue(streamWriter& w, const T& d)
+	{
+		if(w.plain())
+			w.put(static_cast<char>(d));
+		else
+			w.stream() << d;
+	}
+
+	template <class T>
+	typename enable_if<is_integral<T>::value && is_signed<T>::value
+		&& !isCharacter<T>::value>::type
+	writeValue(streamWriter& w, const T& d)
+	{
+		if(!w.plain())
+		{
+			w.stream() << d;
+			return;
+		}
+		unsigned long long magnitude = static_cast<unsigned long long>(d);
+		if(d < 0)
+			magnitude = 0 - magnitude;
+		w.putInteger(magnitude, d < 0);
+	}
+
+	template <class T>
+	typename enable_if<is_integral<T>::value && !is_signed<T>::value
+		&& !is_same<T, bool>::value && !isCharacter<T>::value>::type
+	writeValue(streamWriter& w, const T& d)
+	{
+		if(w.plain())
+			w.putInteger(d);
+		else
+			w.stream() << d;
+	}
+
+	template <class T>
+	typename enable_if<is_floating_point<T>::value>::type
+	writeValue(streamWriter& w, const T& d)
+	{
+		if(w.plain())
+			w.putFloat(d);
+		else
+			w.stream() << d;
+	}
+
+	inline void writeValue(streamWriter& w, const bool& d)
+		{if(w.plain()) w.put(d ? '1' : '0'); else w.stream() << d;}
+	inline void writeValue(streamWriter& w, const string& d)
+		{if(w.plain()) w.put(d.data(), d.size()); else w.stream() << d;}
+
+	template <class T>
+	typename enable_if<!is_arithmetic<T>::value>::type
+	writeValue(streamWriter& w, const T& d)
+	{
+		w.stream() << d;
+	}
+
+	//--------------------------------------------------------------------
+	// BST ITERATOR
+	// walks a tree inorder; holds the path from the root to the current
+	// node since nodes have no parent pointers.  An empty path is end().
+	// Nodes with no copies left (tombstones, see avl<T>::setLazyErase())
+	// are stepped over.
+	// Any change to the tree, other than through the iterator returned by
+	// that change, invalidates it.
+	//--------------------------------------------------------------------
+	template <class T>
+	class bstIterator
+	{
+	public:
+		bstIterator() {}
+		explicit bstIterator(const vector<node<T>*>& path) : m_path(path) {}
+		typename node<T>::valueType operator*() const
+			{return m_path.back()->value();}
+		node<T>* getNode() const
+			{return m_path.empty() ? nullptr : m_path.back();}
+		const vector<node<T>*>& getPath() const {return m_path;}
+		vector<node<T>*>& getPath() {return m_path;}   // for avl<T> inserts
+		bstIterator<T>& operator++()
+			{do advance(); while(atTombstone()); return *this;}
+		bstIterator<T>& operator--()
+			{do retreat(); while(atTombstone()); return *this;}
+		bool operator==(const bstIterator<T>& it) const
+			{return getNode() == it.getNode();}
+		bool operator!=(const bstIterator<T>& it) const
+			{return getNode() != it.getNode();}
+
+		void pushLeftSpine(node<T>* np)
+			{for(; np != nullptr; np = np->left) m_path.push_back(np);}
+		void pushRightSpine(node<T>* np)
+			{for(; np != nullptr; np = np->right) m_path.push_back(np);}
+		bstIterator<T>& skipTombstones(bool backward = false)
+			{return !atTombstone() ? *this : backward ? --*this : ++*this;}
+	private:
+		bool atTombstone() const
+			{return !m_path.empty() && m_path.back()->getCount() == 0;}
+		void advance();
+		void retreat();
+
+		vector<node<T>*> m_path;
+	};
+
+	//--------------------------------------------------------------------
+	// steps to the inorder successor node, or to end()
+	//--------------------------------------------------------------------
+	template <class T>
+	void bstIterator<T>::advance()
+	{
+		node<T>* cur = m_path.back();
+		if(cur->right != nullptr)
+		{
+			pushLeftSpine(cur->right);
+			return;
+		}
+		m_path.pop_back();    // climb until we leave a left subtree
+		while(!m_path.empty() && m_path.back()->right == cur)
+		{
+			cur = m_path.back();
+			m_path.pop_back();
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// steps to the inorder predecessor node
+	// pre: not begin(); end() has no way back, so it stays end()
+	//--------------------------------------------------------------------
+	template <class T>
+	void bstIterator<T>::retreat()
+	{
+		if(m_path.empty())
+			return;
+		node<T>* cur = m_path.back();
+		if(cur->left != nullptr)
+		{
+			pushRightSpine(cur->left);
+			return;
+		}
+		m_path.pop_back();
+		while(!m_path.empty() && m_path.back()->left == cur)
+		{
+			cur = m_path.back();
+			m_path.pop_back();
+		}
+	}
+
 	//--------------------------------------------------------------------
 	// Binary Search Tree -- Basic Implementation
 	//--------------------------------------------------------------------
@@ -113,41 +666,66 @@ namespace AW_BST
 	class bst
 	{    
 	public:
+		typedef bstIterator<T> iterator;
 
 		//constructors
-		bst() : root(nullptr), parentptr(&root) {}
-		bst(const bst<T>& t) : root(nullptr), parentptr(&root)
+		explicit bst(bool multiset = false) : root(nullptr),
+			parentptr(&root), m_multiset(multiset) {}
+		bst(const bst<T>& t) : root(nullptr), parentptr(&root),
+			m_multiset(t.m_multiset)
 			{if(t.root != nullptr) root = new node<T>(*(t.root));}
 
 		//accessor for root of tree
 		node<T>* &getroot() {return root;}
 
 	  	bool isempty() const {return (root == nullptr);}
+		bool isMultiset() const {return m_multiset;}
 	  
 		bst<T>& operator=(const bst<T>& t);
 		bst<T>& operator+=(const bst<T>& t);
-		bst<T>& operator+=(const T d){insert(d, root); return *this;}
+		bst<T>& operator+=(const T d){insert(d); return *this;}
 	 	bst<T> operator+(const T d) {bst<T> temp = *this;
-			temp.insert(d, temp.root); return temp;}  
+			temp.insert(d); return temp;}  
 	  	void findFirstOf(const T& d, node<T>* &np, node<T>* &match);
+		node<T>* find(const T& d) const;
+		bool contains(const T& d) const {return find(d) != nullptr;}
+		void findMany(const T* keys, size_t count, node<T>** results) const;
+		void findMany(const vector<T>& keys, vector<node<T>*>& results)
+			const {results.resize(keys.size());
+			findMany(keys.data(), keys.size(), results.data());}
+		size_t count(const T& d) const
+			{node<T>* np = find(d); return np ? np->getCount() : 0;}
+		size_t size() const {return root ? root->getWeight() : 0;}
+		size_t rank(const T& d) const;
+		typename node<T>::valueType select(size_t k) const;
+		iterator begin() const
+			{iterator it; it.pushLeftSpine(root); return it.skipTombstones();}
+		iterator end() const {return iterator();}
+		iterator last() const
+			{iterator it; it.pushRightSpine(root);
+			return it.skipTombstones(true);}
+		iterator lowerBound(const T& d) const;
 	  	void insert(T d);
 		void delTree() {delTree(root);}
 		void print(ostream& out)const {print(root, out);}
 		void print(node<T>* cur, ostream& out) const;
+		void printPrefix(ostream& out, size_t count) const;
 		void printXlevel(ostream& out) const {printXlevel(root, out);}
 		void printXlevel(node<T>* cur, ostream& out) const;
 		void print(node<T>* cur, ostream& out, int level2print) const;
+		template <class Visitor>
+		void levelOrder(Visitor visit) const;
+		void printJSON(ostream& out) const;
+		void printDOT(ostream& out) const;
 		T popNode(node<T>* &cur);
 		T popLow(node<T>* &cur);
-		T popHigh(node<T>* &cur);
+		T popHigh(node<T>* &cur) {return popHigh(cur, false);}
 		T popFirstOf(const T& d) {return popFirstOf(d, root);}
 		T popFirstOf(const T& d, node<T>*& np);
 		int getHeight() const
 			{if(isempty()) return 0; return root->getHeight();}
 		void setHeight() {if(root != nullptr) root->setHeight();}
-		
-		void setLevel(node<T>* cur, vector<T>& levelVector,
-            int level2print, int position = 0) const;
+
 		int getNumberOfNodes() const {return getNumberOfNodes(root);}
 		int getNumberOfNodes(node<T>* np) const;
 		void delTree(node<T>* &cur);
@@ -156,8 +734,15 @@ namespace AW_BST
 	  	bool insert(T d, node<T>* &cur);
 		node<T>* root; // root of this tree
 		node<T>** parentptr; // holding pointer needed by some functions
+		bool m_multiset;     // duplicates counted in place, not dropped
+
+		void reserveRoom(size_t more) const   // throws length_error
+			{if(more > node<T>::MAX_WEIGHT - size())
+				throw (length_error("Tree is full"));}
 
 		void addTree(const node<T>* np); // used by +
+	private:
+		T popHigh(node<T>* &cur, bool wholeNode);
 	}; 
 
 	//--------------------------------------------------------------------
@@ -175,6 +760,7 @@ namespace AW_BST
 			{
 				root = new node<T>(*(t.root));
 			}
+			m_multiset = t.m_multiset;
 		}
 		return *this;
 	}
@@ -200,7 +786,8 @@ namespace AW_BST
 		{
 			addTree(np->left);
 			addTree(np->right);
-			insert(np->value(), root);
+			for(size_t i = 0; i < np->getCount(); i++)
+				insert(np->value(), root);
 		}
 	}
 
@@ -226,6 +813,139 @@ namespace AW_BST
 		}
 	}
 
+	//--------------------------------------------------------------------
+	// finds the node holding d by descending from the root
+	// returns nullptr if d is not in the tree, or only its tombstone is
+	//--------------------------------------------------------------------
+	template <class T>
+	node<T>* bst<T>::find(const T& d) const
+	{
+		node<T>* cur = root;
+		while(cur != nullptr && !(d == cur->value()))
+			cur = cur->child(cur->value() < d);
+		return (cur != nullptr && cur->getCount() != 0) ? cur : nullptr;
+	}
+
+	//--------------------------------------------------------------------
+	// looks up count keys, storing the node holding each (or nullptr) in
+	// results.  Up to FIND_GROUP descents advance one level per round,
+	// each prefetching its next node, so their cache misses overlap
+	// instead of being paid one after another.
+	//--------------------------------------------------------------------
+	template <class T>
+	void bst<T>::findMany(const T* keys, size_t count, node<T>** results)
+		const
+	{
+		node<T>* cur[FIND_GROUP];
+		size_t which[FIND_GROUP];    // index of the key each lane seeks
+		size_t active = 0;
+		size_t next = 0;
+		for(; active < FIND_GROUP && next < count; active++, next++)
+		{
+			cur[active] = root;
+			which[active] = next;
+		}
+		while(active > 0)
+		{
+			for(size_t i = 0; i < active; )
+			{
+				node<T>* np = cur[i];
+				const T& d = keys[which[i]];
+				if(np != nullptr && !(d == np->value()))
+				{
+					np = np->child(np->value() < d);
+					prefetchNode(np);
+					cur[i++] = np;
+					continue;
+				}
+				results[which[i]] = (np != nullptr && np->getCount() != 0)
+					? np : nullptr;
+				if(next < count)
+				{   // start the next key in this lane
+					cur[i] = root;
+					which[i++] = next++;
+				}
+				else
+				{   // close the lane; the last one moves into its place
+					active--;
+					cur[i] = cur[active];
+					which[i] = which[active];
+				}
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// returns how many elements (duplicates included) are less than d
+	//--------------------------------------------------------------------
+	template <class T>
+	size_t bst<T>::rank(const T& d) const
+	{
+		size_t less = 0;
+		for(node<T>* cur = root; cur != nullptr; )
+		{
+			if(cur->value() < d)
+			{
+				less += cur->getCount();
+				if(cur->left != nullptr)
+					less += cur->left->getWeight();
+				cur = cur->right;
+			}
+			else
+				cur = cur->left;
+		}
+		return less;
+	}
+
+	//--------------------------------------------------------------------
+	// returns the element at rank k (counting duplicates), the inverse
+	// of rank(); O(height)
+	// throws out_of_range if k >= size()
+	//--------------------------------------------------------------------
+	template <class T>
+	typename node<T>::valueType bst<T>::select(size_t k) const
+	{
+		if(k >= size())
+			throw (out_of_range("Rank is past the end of the tree"));
+		node<T>* cur = root;
+		for(;;)
+		{
+			size_t below = cur->left ? cur->left->getWeight() : 0;
+			if(k < below)
+				cur = cur->left;
+			else if(k - below < cur->getCount())
+				return cur->value();
+			else
+			{
+				k -= below + cur->getCount();
+				cur = cur->right;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// returns an iterator to the first element not less than d
+	//--------------------------------------------------------------------
+	template <class T>
+	bstIterator<T> bst<T>::lowerBound(const T& d) const
+	{
+		vector<node<T>*> path;
+		size_t keep = 0;      // path length up to the best candidate
+		for(node<T>* cur = root; cur != nullptr; )
+		{
+			path.push_back(cur);
+			if(cur->value() < d)
+				cur = cur->right;
+			else
+			{
+				keep = path.size();
+				cur = cur->left;
+			}
+		}
+		path.resize(keep);
+		return iterator(path).skipTombstones();
+	}
+
 	//--------------------------------------------------------------------
 	// inserts a new element
 	// into the tree
@@ -233,6 +953,7 @@ namespace AW_BST
 	template <class T>
 	void bst<T>::insert(T d)
 	{
+		reserveRoom(1);
 		insert(d, root);
 	}
 	//--------------------------------------------------------------------
@@ -254,7 +975,14 @@ namespace AW_BST
 		else
 		{
 			if (d == cur->value())
+			{
+				if(m_multiset)
+				{
+					cur->setCount(cur->getCount() + 1);
+					cur->update();
+				}
 				return duplicate;
+			}
 			else if (d < cur->value())
 			{
 				insert(d, cur->left);
@@ -272,102 +1000,271 @@ namespace AW_BST
 	} 
 
 	//-------------------------------------------------------------------- 
-	// recursively prints out the tree inorder
+	// prints out the subtree inorder, at most count elements
+	// iterative, buffered; a trailing "..." marks a cut-off listing
 	//--------------------------------------------------------------------
 	template <class T>
-	void bst<T>::print(node<T>* cur, ostream& out) const 
+	void printInorder(const node<T>* cur, ostream& out, size_t count)
 	{
-		if(cur != nullptr)
+		streamWriter w(out);
+		vector<const node<T>*> pending;
+		while(cur != nullptr || !pending.empty())
 		{
-			print(cur->left, out);
-			out << cur->value() << "(" << cur->getHeight() << ") ";
-			print(cur->right, out);
+			for(; cur != nullptr; cur = cur->left)
+				pending.push_back(cur);
+			cur = pending.back();
+			pending.pop_back();
+			if(cur->getCount() == 0)
+			{   // a tombstone
+				cur = cur->right;
+				continue;
+			}
+			if(count == 0)
+			{
+				w.put("...");
+				return;
+			}
+			count--;
+			writeValue(w, cur->value());
+			w.put('(');
+			writeValue(w, cur->getHeight());
+			w.put(')');
+			if(cur->getCount() > 1)
+			{
+				w.put('x');
+				writeValue(w, cur->getCount());
+			}
+			w.put(' ');
+			cur = cur->right;
 		}
-	} 
+	}
+
+	//-------------------------------------------------------------------- 
+	// prints out the tree inorder
+	//--------------------------------------------------------------------
+	template <class T>
+	void bst<T>::print(node<T>* cur, ostream& out) const
+	{
+		printInorder<T>(cur, out, static_cast<size_t>(-1));
+	}
+
+	//-------------------------------------------------------------------- 
+	// prints out the first count elements of the tree inorder
+	//--------------------------------------------------------------------
+	template <class T>
+	void bst<T>::printPrefix(ostream& out, size_t count) const
+	{
+		printInorder<T>(root, out, count);
+	}
 	
 	//------------------------------------------------------------------------
-	// recursuively sets levelVector to represent the specified level 
+	// visits every node in level order, calling visit(np, level)
+	// single breadth-first pass; holds at most two levels of pointers
+	// tombstones (count 0) are walked through but not visited
 	//------------------------------------------------------------------------
 	template <class T>
-	void bst<T>::setLevel(node<T>* cur, vector<T>& levelVector,
-		int level2print, int position) const 
-	{	
-		static int currentLevel = -1;
-		if(level2print < 0)
-			return;
-		if(cur != nullptr)
-		{
-			currentLevel++;
-			if(currentLevel < level2print)
-				setLevel(cur->left, levelVector, level2print, position * 2);
-			if(currentLevel == level2print)
-				levelVector[position] = cur->value();
-			if(currentLevel < level2print)
-				setLevel(cur->right, levelVector, level2print,
-					position * 2 + 1);
-			currentLevel--;
+	template <class Visitor>
+	void bst<T>::levelOrder(Visitor visit) const
+	{
+		vector<const node<T>*> level;
+		vector<const node<T>*> nextLevel;
+		if(root != nullptr)
+			level.push_back(root);
+		for(int depth = 0; !level.empty(); depth++)
+		{
+			for(size_t i = 0; i < level.size(); i++)
+			{
+				if(level[i]->getCount() != 0)
+					visit(level[i], depth);
+				if(level[i]->left != nullptr)
+					nextLevel.push_back(level[i]->left);
+				if(level[i]->right != nullptr)
+					nextLevel.push_back(level[i]->right);
+			}
+			level.swap(nextLevel);
+			nextLevel.clear();
 		}
-	} 
+	}
 
-	//------------------------------------------------------------------------ 
+	//------------------------------------------------------------------------
 	// prints out the tree in level order
-	// pre: -1 must be able to be cast to T
+	// only the first PRINT_MAX levels are walked; gaps are tracked by
+	// position, so no sentinel value of T is needed; a tombstone prints
+	// as a gap
 	//------------------------------------------------------------------------
 	template <class T>
-	void bst<T>::printXlevel(node<T>* cur, ostream& out) const 
-	{	
+	void bst<T>::printXlevel(node<T>* cur, ostream& out) const
+	{
 		if(cur == nullptr)
 			return;
 		const size_t SPACER = 64;
-		const T NO_NODE = static_cast<T>(-1);
 		const int PRINT_MAX = 6;
-		vector<vector<T>> treeVector(cur->getHeight());
-		
+		// node and its slot within the level, 0 .. 2^level - 1
+		vector<pair<const node<T>*, int>> level(1, make_pair(cur, 0));
+		vector<pair<const node<T>*, int>> nextLevel;
+
 		for(int i = 0; i < cur->getHeight(); i++)
 		{
 			out << "level " << i + 1 << ": ";
 			if(i < PRINT_MAX)
 			{
-				int size = static_cast<int>(pow(2.0, i));
-				treeVector[i] = vector<T>(size, NO_NODE);
-				setLevel(cur, treeVector[i], i);
-				out << string(SPACER / (2 * size), ' '); 
-				for(int j = 0; j < static_cast<int>(treeVector[i].size());
-					j++)
+				int size = 1 << i;
+				size_t next = 0;
+				out << string(SPACER / (2 * size), ' ');
+				for(int j = 0; j < size; j++)
 				{
-					if(treeVector[i][j] != NO_NODE)
-						out  << treeVector[i][j];
+					const node<T>* np = nullptr;
+					if(next < level.size() && level[next].second == j)
+						np = level[next++].first;
+					if(np != nullptr && np->getCount() != 0)
+						out << np->value();
 					else
-						out  << ' ';
+						out << ' ';
 					out << string(SPACER / size - 1, ' ');
 				}
+				for(size_t k = 0; k < level.size(); k++)
+				{
+					const node<T>* np = level[k].first;
+					int position = level[k].second;
+					if(np->left != nullptr)
+						nextLevel.push_back(make_pair(np->left, position * 2));
+					if(np->right != nullptr)
+						nextLevel.push_back(
+							make_pair(np->right, position * 2 + 1));
+				}
+				level.swap(nextLevel);
+				nextLevel.clear();
 			}
-			else 
+			else
 				out << "  . . .";
-			
+
 			out << endl;
 		}
-	} 
+	}
+
+	//------------------------------------------------------------------------
+	// writes the tree shape as nested JSON objects:
+	// {"value":v,"height":h,"left":{...}|null,"right":{...}|null}
+	// iterative, so a degenerate (list-shaped) bst cannot overflow the stack
+	// a tombstone's value is written as null
+	//------------------------------------------------------------------------
+	template <class T>
+	void bst<T>::printJSON(ostream& out) const
+	{
+		// stage 0: open the node, 1: between children, 2: close it
+		vector<pair<const node<T>*, int>> pending;
+		if(root == nullptr)
+			out << "null";
+		else
+			pending.push_back(make_pair(root, 0));
+		while(!pending.empty())
+		{
+			const node<T>* np = pending.back().first;
+			int stage = pending.back().second++;
+			const node<T>* child = nullptr;
+			if(stage == 0)
+			{
+				out << "{\"value\":";
+				if(np->getCount() != 0)
+					writeJSONValue(out, np->value());
+				else
+					out << "null";
+				out << ",\"height\":" << np->getHeight() << ",\"left\":";
+				child = np->left;
+			}
+			else if(stage == 1)
+			{
+				out << ",\"right\":";
+				child = np->right;
+			}
+			else
+			{
+				out << '}';
+				pending.pop_back();
+				continue;
+			}
+			if(child != nullptr)
+				pending.push_back(make_pair(child, 0));
+			else
+				out << "null";
+		}
+		out << endl;
+	}
+
+	//------------------------------------------------------------------------
+	// writes the tree shape as a Graphviz digraph
+	// nodes are numbered in level order so any T can be a label; a
+	// tombstone is drawn as an unlabeled point
+	//------------------------------------------------------------------------
+	template <class T>
+	void bst<T>::printDOT(ostream& out) const
+	{
+		vector<pair<const node<T>*, int>> level;
+		vector<pair<const node<T>*, int>> nextLevel;
+		int nextId = 0;
+		out << "digraph bst {" << endl;
+		if(root != nullptr)
+			level.push_back(make_pair(root, nextId++));
+		while(!level.empty())
+		{
+			for(size_t i = 0; i < level.size(); i++)
+			{
+				const node<T>* np = level[i].first;
+				int id = level[i].second;
+				out << "  n" << id;
+				if(np->getCount() != 0)
+				{
+					ostringstream label;
+					label << np->value() << '(' << np->getHeight() << ')';
+					out << " [label=";
+					writeQuoted(out, label.str());
+					out << "];" << endl;
+				}
+				else
+					out << " [shape=point];" << endl;
+				const node<T>* children[2] = {np->left, np->right};
+				for(int c = 0; c < 2; c++)
+				{
+					if(children[c] == nullptr)
+						continue;
+					out << "  n" << id << " -> n" << nextId << ';' << endl;
+					nextLevel.push_back(make_pair(children[c], nextId++));
+				}
+			}
+			level.swap(nextLevel);
+			nextLevel.clear();
+		}
+		out << '}' << endl;
+	}
 
 	//-------------------------------------------------------------------- 
-	// recursively deletes out the subtree
+	// deletes out the subtree
+	// heights are fixed once at the end, not after every node
 	//--------------------------------------------------------------------
 	template <class T>
-	void bst<T>::delTree(node<T>* &cur)   
+	void bst<T>::delTree(node<T>* &cur)
 	{
-		if(cur != nullptr)
+		if(cur == nullptr)
+			return;
+		vector<node<T>*> pending(1, cur);
+		cur = nullptr;
+		while(!pending.empty())
 		{
-			delTree(cur->left);
-			delTree(cur->right);
-			delete cur;
-			cur = nullptr;
-			if(root != nullptr)
-				root->setHeight();
+			node<T>* doomed = pending.back();
+			pending.pop_back();
+			if(doomed->left != nullptr)
+				pending.push_back(doomed->left);
+			if(doomed->right != nullptr)
+				pending.push_back(doomed->right);
+			delete doomed;
 		}
-	} 
+		if(root != nullptr)
+			root->setHeight();
+	}
 
 	//-------------------------------------------------------------------- 
 	// pops a given node
+	// a multiset pops one copy; the node goes with its last one
 	//--------------------------------------------------------------------
 	template <class T>
 	T bst<T>::popNode(node<T>* &cur)  
@@ -375,7 +1272,9 @@ namespace AW_BST
 		if(cur == nullptr)
 			throw (invalid_argument("Pointer does not point to a node"));
 		T contents = cur->value();
-		if(cur->left == nullptr && cur->right == nullptr)
+		if(m_multiset && cur->getCount() > 1)
+			cur->setCount(cur->getCount() - 1);
+		else if(cur->left == nullptr && cur->right == nullptr)
 		{ // no children
 			delete cur;
 			cur = nullptr;
@@ -394,7 +1293,11 @@ namespace AW_BST
 		}
 		else
 		{ // two children
-			cur->setdata(popHigh(cur->left));
+			node<T>* predecessor = cur->left;
+			while(predecessor->right != nullptr)
+				predecessor = predecessor->right;
+			cur->setCount(predecessor->getCount());
+			cur->setdata(popHigh(cur->left, true));
 			// pops leftmost node of right child and
 			// places that value into the current node
 		}
@@ -405,6 +1308,7 @@ namespace AW_BST
 	
 	//-------------------------------------------------------------------- 
 	// pops out the leftmost child of cur
+	// a multiset pops one copy; the node goes with its last one
 	//--------------------------------------------------------------------
 	template <class T>
 	T bst<T>::popLow(node<T>* &cur)  
@@ -414,9 +1318,14 @@ namespace AW_BST
 		if(cur->left == nullptr)
 		{
 			T temp = cur->value();
-			node<T>* temptr = cur->right;
-			delete cur;
-			cur = temptr;
+			if(m_multiset && cur->getCount() > 1)
+				cur->setCount(cur->getCount() - 1);
+			else
+			{
+				node<T>* temptr = cur->right;
+				delete cur;
+				cur = temptr;
+			}
 			if(root != nullptr)
 				root->setHeight();
 			return temp;
@@ -426,24 +1335,31 @@ namespace AW_BST
 
 	//------------------------------------------------------------------------
 	// pops out the rightmost child of cur
+	// a multiset pops one copy unless wholeNode, as when popNode() moves
+	// the node's data up; the node goes with its last copy
 	// throws invalid_argument
 	//------------------------------------------------------------------------
 	template <class T>
-	T bst<T>::popHigh(node<T>* &cur)  
+	T bst<T>::popHigh(node<T>* &cur, bool wholeNode)  
 	{
 		if(cur == nullptr)
 			throw(invalid_argument("Pointer does not point to a node"));
 		if(cur->right == nullptr)
 		{
 			T temp = cur->value();
-			node<T>* temptr = cur->left;
-			delete cur;
-			cur = temptr;
+			if(m_multiset && cur->getCount() > 1 && !wholeNode)
+				cur->setCount(cur->getCount() - 1);
+			else
+			{
+				node<T>* temptr = cur->left;
+				delete cur;
+				cur = temptr;
+			}
 			if(root != nullptr)
 				root->setHeight();
 			return temp;
 		}
-		return popHigh(cur->right);
+		return popHigh(cur->right, wholeNode);
 	}
 
 	//-------------------------------------------------------------------- 
@@ -465,29 +1381,38 @@ namespace AW_BST
 	}
 
 	//-------------------------------------------------------------------- 
-	// returns the number of nodes in the tree
-	// recursive
+	// returns the number of nodes in the subtree, tombstones (count 0)
+	// left out
+	// iterative, so a degenerate (list-shaped) bst cannot overflow the stack
 	//--------------------------------------------------------------------
 	template <class T>
 	int bst<T>::getNumberOfNodes(node<T>* np) const
 	{
-		int count  = 1;
+		int count = 0;
+		vector<const node<T>*> pending;
 		if(np != nullptr)
-		{ 
-			count += getNumberOfNodes(np->left);			
-			count += getNumberOfNodes(np->right);
-			return count;
+			pending.push_back(np);
+		while(!pending.empty())
+		{
+			const node<T>* cur = pending.back();
+			pending.pop_back();
+			if(cur->getCount() != 0)
+				count++;
+			if(cur->left != nullptr)
+				pending.push_back(cur->left);
+			if(cur->right != nullptr)
+				pending.push_back(cur->right);
 		}
-		return 0;
+		return count;
 	}
 
 	//--------------------------------------------------------------------  
 	// Overloaded << for bst<T>
 	//--------------------------------------------------------------------
 	template <class T>
-	ostream& operator<<(ostream& out, bst<T> tree)
+	ostream& operator<<(ostream& out, const bst<T>& tree)
 	{
-		tree.print(tree.getroot(), out);
+		tree.print(out);
 		return out;
 	}
 
@@ -16,6 +16,7 @@
 #include <cstdlib>
 #include "bst.h"
 #include "avl.h";
+#include "keyLoader.h"
 using namespace std;
 
 //---------------------------------------------------------------------------
@@ -32,26 +33,41 @@ using namespace std;
 //				Compiles under Microsoft Visual C++ 2015
 // 
 // Input:		User-supplied elements to fill and test an inherited AVL tree
+//				or, when a file name is given, newline-separated keys
+//				from that file ("-" reads standard input)
 // Output:		Various operations performed on a AVL tree inherited from a
 //				binary search tree
 // Calls:		bst base class and it's inherited avl class
 // Called By:	n/a
-// Parameters:  None
+// Parameters:  int argc, char* argv[]; optional key file to bulk load
 // Returns:		EXIT_SUCCESS  upon successful execution
 //
 // History Log:	05-24-17 AW Began Project
 //				06-05-17 AW Completed project
+//				10-19-26 AW Added bulk key file loading
 // Known Bugs:  avl<T>::popnode() does not properly rebalance the avl tree
 //				avl<T>::poplow() does not properly rebalance the avl tree
 //				avl<T>::popfirst() does not properly rebalance the avl tree
 //----------------------------------------------------------------------------
-int main(void)
+int main(int argc, char* argv[])
 {
 	using AW_BST::bst;
 	using AW_BST::node;
 	using AW_BST::avl;
+	using AW_BST::loadKeys;
+	using AW_BST::loadStats;
 	try
 	{
+		if(argc > 1)
+		{
+			avl<string> keys;
+			string fileName = argv[1];
+			loadStats stats = (fileName == "-") ? loadKeys(cin, keys)
+				: loadKeys(fileName, keys);
+			cout << stats << endl;
+			return EXIT_SUCCESS;
+		}
+
 		avl<char> tree;
 		avl<char> tree2;
 		avl<char> tree3;
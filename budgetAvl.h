@@ -0,0 +1,301 @@
+#ifndef BUDGETAVL_H
+#define BUDGETAVL_H
+//--------------------------------------------------------------------
+// An avl tree that knows its memory use and can be held to a budget
+//--------------------------------------------------------------------
+#include <functional>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// estimates the heap bytes one allocation of n bytes takes: rounded
+	// up to 16 with an 8-byte header and a 32-byte minimum, as the usual
+	// 64-bit allocators (glibc, the Windows heap) lay out small blocks
+	//--------------------------------------------------------------------
+	inline size_t heapBytes(size_t n)
+	{
+		size_t block = (n + sizeof(void*) + 15) & ~static_cast<size_t>(15);
+		return (block < 32) ? 32 : block;
+	}
+
+	//--------------------------------------------------------------------
+	// keyHeapBytes overloads -- heap bytes a key owns outside the node;
+	// add an overload here to account for a new key type.  They go by
+	// length, not capacity: a node's key may be assigned over (an erase
+	// moves the successor's key up), which keeps the old buffer, so the
+	// capacity of a stored key is not fixed between two changes.  The
+	// count is therefore a lower bound: a key may hold a buffer as large
+	// as the longest key its node ever held, even when it is itself short
+	// enough to fit inline.
+	//--------------------------------------------------------------------
+	template <class T>
+	inline size_t keyHeapBytes(const T&) {return 0;}
+
+	template <class C, class Traits, class Alloc>
+	inline size_t keyHeapBytes(const basic_string<C, Traits, Alloc>& s)
+	{
+		static const size_t inlineChars =
+			basic_string<C, Traits, Alloc>().capacity();   // no heap up to here
+		return (s.size() > inlineChars) ? heapBytes((s.size() + 1) * sizeof(C))
+			: 0;
+	}
+
+	template <class U, class Alloc>
+	inline size_t keyHeapBytes(const vector<U, Alloc>& v)
+	{
+		return v.empty() ? 0 : heapBytes(v.size() * sizeof(U));
+	}
+
+	//--------------------------------------------------------------------
+	// what a budgetAvl<T> does once it is over budget: evict from one
+	// end, call its over-budget callback, or refuse new nodes
+	//--------------------------------------------------------------------
+	enum budgetPolicy {evictLowest, evictHighest, notifyOnly, rejectInsert};
+
+	//--------------------------------------------------------------------
+	// Budgeted AVL Tree
+	// Class:		budgetAvl<T>
+	//				REQUIRES Type T be copyable & have < & ==
+	//				defined; keys that own heap memory need a
+	//				keyHeapBytes overload (string & vector have one)
+	//
+	// File:		budgetAvl.h
+	// Title:		budgetAvl template Class
+	// Description: An avl<T> that keeps a running count of the heap bytes
+	//				its nodes take (node size plus allocator overhead)
+	//				and of the bytes its keys own outside the nodes, so
+	//				memoryUsage() is O(1).  Every change goes through this
+	//				class, which adjusts the count when a node is created
+	//				or freed.  Key bytes are counted by length, so the
+	//				count may fall short by the spare capacity of the
+	//				stored keys (see keyHeapBytes).
+	//
+	//				With a budget set, an insert that leaves the tree over
+	//				it evicts from the low or high end until it fits,
+	//				calling the eviction callback for each key, or calls
+	//				the over-budget callback, or is refused up front with
+	//				length_error, as the policy says.  Evicting from the
+	//				low end may evict the key just inserted.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class budgetAvl<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			budgetAvl(bool multiset = false) -- constructor
+	//			bool contains(const T& d) const -- true if d is present
+	//			size_t count(const T& d) const -- copies of d present
+	//			size_t size() const -- number of keys
+	//			bool isempty() const -- true if the tree is empty
+	//			valueType min() const -- smallest key
+	//			valueType max() const -- largest key
+	//			T popMin() -- removes & returns the smallest key
+	//			T popMax() -- removes & returns the largest key
+	//			void clear() -- removes every key
+	//			size_t memoryUsage() const -- heap bytes, O(1)
+	//			size_t budget() const -- the budget, 0 if none
+	//			void setBudget(size_t bytes, budgetPolicy policy)
+	//				-- sets a budget (0 for none) and enforces it
+	//			void onEvict(function<void(const T&)> f)
+	//				-- called with each evicted key
+	//			void onOverBudget(function<void(size_t, size_t)> f)
+	//				-- called with the usage and budget when over
+	//			const avl<T>& tree() const -- the tree itself
+	//			void print(ostream& out) const -- prints the tree inorder
+	//
+	//     non-inline:
+	//			bool insert(const T& d) -- adds d
+	//			bool erase(const T& d) -- removes one copy of d
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a batch of keys
+	//		private:
+	//			size_t nodeBytes(const T& d) const
+	//				-- heap bytes of a node holding d
+	//			T popEnd(bool high) -- pops an end, counting the bytes
+	//			void enforce() -- applies the policy if over budget
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class budgetAvl
+	{
+	public:
+		typedef typename avl<T>::valueType valueType;
+
+		explicit budgetAvl(bool multiset = false) : m_tree(multiset),
+			m_usage(0), m_budget(0), m_policy(evictLowest) {}
+
+		bool insert(const T& d);
+		bool erase(const T& d);
+		template <class InputIt>
+		int bulkInsert(InputIt first, InputIt last);
+		bool contains(const T& d) const {return m_tree.contains(d);}
+		size_t count(const T& d) const {return m_tree.count(d);}
+		size_t size() const {return m_tree.size();}
+		bool isempty() const {return m_tree.isempty();}
+		valueType min() const {return m_tree.min();}
+		valueType max() const {return m_tree.max();}
+		T popMin() {return popEnd(false);}
+		T popMax() {return popEnd(true);}
+		void clear() {m_tree.delTree(); m_usage = 0;}
+		size_t memoryUsage() const {return m_usage;}
+		size_t budget() const {return m_budget;}
+		void setBudget(size_t bytes, budgetPolicy policy = evictLowest)
+			{m_budget = bytes; m_policy = policy; enforce();}
+		void onEvict(function<void(const T&)> f) {m_onEvict = f;}
+		void onOverBudget(function<void(size_t, size_t)> f)
+			{m_onOverBudget = f;}
+		const avl<T>& tree() const {return m_tree;}
+		void print(ostream& out) const {m_tree.print(out);}
+
+	private:
+		size_t nodeBytes(const T& d) const
+			{return heapBytes(sizeof(node<T>)) + keyHeapBytes(d);}
+		T popEnd(bool high);
+		void enforce();
+
+		avl<T> m_tree;
+		size_t m_usage;      // heap bytes of nodes and their keys
+		size_t m_budget;     // 0 for none
+		budgetPolicy m_policy;
+		function<void(const T&)> m_onEvict;
+		function<void(size_t, size_t)> m_onOverBudget;
+	};
+
+	//--------------------------------------------------------------------
+	// adds d, counting the node it creates, then enforces the budget.
+	// Under rejectInsert, a new node that would not fit is refused.
+	// returns false for a duplicate in a set
+	// throws length_error, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool budgetAvl<T>::insert(const T& d)
+	{
+		bool fresh = !m_tree.contains(d);   // a copy adds no node
+		if(fresh && m_policy == rejectInsert && m_budget != 0
+			&& m_usage + nodeBytes(d) > m_budget)
+			throw (length_error("Memory budget exceeded"));
+		if(!m_tree.insert(d))
+			return false;
+		if(fresh)
+			m_usage += nodeBytes(d);
+		enforce();
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// removes one copy of d, uncounting its node once the last copy goes
+	// returns false if d is not present
+	//--------------------------------------------------------------------
+	template <class T>
+	bool budgetAvl<T>::erase(const T& d)
+	{
+		const node<T>* np = m_tree.find(d);
+		if(np == nullptr)
+			return false;
+		size_t bytes = (np->getCount() == 1) ? nodeBytes(np->value()) : 0;
+		m_tree.erase(d);
+		m_usage -= bytes;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// adds a batch of keys with avl<T>::bulkInsert(), counting a node
+	// for each distinct key that was not already present, then enforces
+	// the budget (rejectInsert checks the whole batch up front)
+	// returns the number of keys inserted
+	// throws length_error, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class InputIt>
+	int budgetAvl<T>::bulkInsert(InputIt first, InputIt last)
+	{
+		vector<T> batch(first, last);
+		vector<T> fresh(batch);
+		sort(fresh.begin(), fresh.end());
+		fresh.erase(unique(fresh.begin(), fresh.end()), fresh.end());
+		size_t kept = 0;
+		size_t bytes = 0;
+		for(size_t i = 0; i < fresh.size(); i++)
+		{
+			if(!m_tree.contains(fresh[i]))
+			{
+				bytes += nodeBytes(fresh[i]);
+				fresh[kept++] = fresh[i];
+			}
+		}
+		fresh.resize(kept);
+		if(m_policy == rejectInsert && m_budget != 0
+			&& m_usage + bytes > m_budget)
+			throw (length_error("Memory budget exceeded"));
+		int inserted = m_tree.bulkInsert(batch.begin(), batch.end());
+		for(size_t i = 0; i < fresh.size(); i++)
+			m_usage += nodeBytes(fresh[i]);
+		enforce();
+		return inserted;
+	}
+
+	//--------------------------------------------------------------------
+	// pops the smallest or largest key, uncounting its node once the
+	// last copy goes
+	// throws invalid_argument if the tree is empty
+	//--------------------------------------------------------------------
+	template <class T>
+	T budgetAvl<T>::popEnd(bool high)
+	{
+		if(m_tree.isempty())
+			throw (invalid_argument("Tree is empty"));
+		const node<T>* np = m_tree.find(high ? m_tree.max() : m_tree.min());
+		size_t bytes = (np->getCount() == 1) ? nodeBytes(np->value()) : 0;
+		T d = high ? m_tree.popMax() : m_tree.popMin();
+		m_usage -= bytes;
+		return d;
+	}
+
+	//--------------------------------------------------------------------
+	// if a budget is set and exceeded, evicts from the policy's end
+	// until the tree fits, or reports the overrun
+	//--------------------------------------------------------------------
+	template <class T>
+	void budgetAvl<T>::enforce()
+	{
+		if(m_budget == 0 || m_usage <= m_budget)
+			return;
+		if(m_policy == evictLowest || m_policy == evictHighest)
+		{
+			while(m_usage > m_budget && !m_tree.isempty())
+			{
+				T d = popEnd(m_policy == evictHighest);
+				if(m_onEvict)
+					m_onEvict(d);
+			}
+		}
+		else if(m_onOverBudget)
+			m_onOverBudget(m_usage, m_budget);
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for budgetAvl<T>
+	//--------------------------------------------------------------------
+	template <class T>
+	ostream& operator<<(ostream& out, const budgetAvl<T>& tree)
+	{
+		tree.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -0,0 +1,146 @@
+//----------------------------------------------------------------------------
+// File:		compactBench.cpp
+//
+// Description: Benchmark of avl<T>::compact(): inorder walks and lookups
+//				on a tree scattered through memory by random inserts and
+//				erases, before and after compacting it
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				timeWalks()
+//				timeLookups()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <random>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	const int WALKS = 5;
+
+	//---------------------------------------------------------------------------
+	// Function:	timeWalks()
+	// Title:		Times inorder walks
+	// Description: Walks the whole tree in order with its iterator WALKS
+	//				times
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::begin(), end()
+	// Called By:	main()
+	// Parameters:	const avl<int>& tree; tree to walk
+	//				long long& sum; set to the sum of the keys seen
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double timeWalks(const AW_BST::avl<int>& tree, long long& sum)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		sum = 0;
+		for(int w = 0; w < WALKS; w++)
+			for(AW_BST::avl<int>::iterator it = tree.begin(); it != tree.end(); ++it)
+				sum += *it;
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	timeLookups()
+	// Title:		Times random lookups
+	// Description: Looks up count random keys in [0, range), the same keys
+	//				on every call
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::contains()
+	// Called By:	main()
+	// Parameters:	const avl<int>& tree; tree to search
+	//				int count; lookups
+	//				int range; keys are drawn from [0, range)
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double timeLookups(const AW_BST::avl<int>& tree, int count, int range)
+	{
+		mt19937 rng(1);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long hits = 0;
+		for(int i = 0; i < count; i++)
+			hits += tree.contains(static_cast<int>(rng() % range));
+		AW_BST::keepResult(hits);
+		return AW_BST::secondsSince(start);
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		compact() benchmark
+// Description: Runs 3n random operations on keys in [0, 2n), two thirds
+//				inserts and one third erases, then times WALKS inorder
+//				walks and 2n lookups before and after compact()
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: n (default 1000000)
+// Output:		seconds before and after, and the time compact() took
+// Calls:		timeWalks(), timeLookups()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS, or EXIT_FAILURE if compact() changed the keys
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int range = 2 * n;
+	mt19937 rng(4);
+	AW_BST::avl<int> tree;
+	for(int i = 0; i < 3 * n; i++)
+	{
+		int k = static_cast<int>(rng() % range);
+		if(rng() % 3 == 0)
+			tree.erase(k);
+		else
+			tree.insert(k);
+	}
+
+	long long sumBefore = 0;
+	long long sumAfter = 0;
+	double walkBefore = timeWalks(tree, sumBefore);
+	double lookupBefore = timeLookups(tree, 2 * n, range);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	tree.compact();
+	double compactTime = AW_BST::secondsSince(start);
+	double walkAfter = timeWalks(tree, sumAfter);
+	double lookupAfter = timeLookups(tree, 2 * n, range);
+
+	cout << fixed << setprecision(3);
+	cout << tree.size() << " nodes after " << 3 * n
+		<< " random inserts and erases" << endl;
+	cout << "  " << WALKS << " inorder walks  " << walkBefore << "s -> "
+		<< walkAfter << "s" << endl;
+	cout << "  " << 2 * n << " lookups  " << lookupBefore << "s -> "
+		<< lookupAfter << "s" << endl;
+	cout << "  compact()  " << compactTime << "s" << endl;
+	if(sumBefore != sumAfter)
+	{
+		cout << "compact() changed the keys" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
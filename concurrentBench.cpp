@@ -0,0 +1,100 @@
+//----------------------------------------------------------------------------
+// File:		concurrentBench.cpp
+//
+// Description: Benchmark of concurrentSet<T> against an avl<T> behind one
+//				mutex, on mixed workloads of three read shares at 1 to
+//				64 threads
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+#include <mutex>
+#include "avl.h"
+#include "concurrentSet.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// avl<int> behind a single mutex, shaped like concurrentSet<int>
+	//---------------------------------------------------------------------------
+	class lockedAvl
+	{
+	public:
+		bool insert(int d) {lock_guard<mutex> lock(m_lock); return m_tree.insert(d);}
+		bool erase(int d) {lock_guard<mutex> lock(m_lock); return m_tree.erase(d);}
+		bool contains(int d)
+			{lock_guard<mutex> lock(m_lock); return m_tree.contains(d);}
+	private:
+		mutex m_lock;
+		AW_BST::avl<int> m_tree;
+	};
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		concurrentSet scaling benchmark
+// Description: Prints millions of operations per second for
+//				concurrentSet<int> and a mutex-wrapped avl<int> at 1, 2, 4
+//				... 64 threads, for read shares of 95%, 80% and 50% (the
+//				writes split evenly between inserts and erases).
+//				Scaling needs as many cores as threads.
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional arguments: operations per thread (default
+//				1000000) and key range (default 1000000)
+// Output:		one table per read share, one line per thread count
+// Calls:		runMix()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//				10-19-26 AW sweeps the read share
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	long ops = (argc > 1) ? atol(argv[1]) : 1000000;
+	int range = (argc > 2) ? atoi(argv[2]) : 1000000;
+	const int READ_PERCENTS[] = {95, 80, 50};
+	cout << range << " keys; " << thread::hardware_concurrency() << " cores"
+		<< endl;
+	for(int m = 0; m < 3; m++)
+	{
+		int reads = READ_PERCENTS[m];
+		cout << endl << "mix: " << reads << "% contains, "
+			<< (100 - reads) / 2.0 << "% insert, " << (100 - reads) / 2.0
+			<< "% erase" << endl;
+		cout << "threads  concurrentSet Mops/s  locked avl Mops/s" << endl;
+		for(int threads = 1; threads <= 64; threads *= 2)
+		{
+			double lockFree;
+			double locked;
+			{
+				AW_BST::concurrentSet<int> set;
+				lockFree = AW_BST::runMix(set, threads, ops, range, reads);
+			}
+			{
+				lockedAvl set;
+				locked = AW_BST::runMix(set, threads, ops, range, reads);
+			}
+			cout << setw(7) << threads << setw(22) << fixed << setprecision(2)
+				<< lockFree / 1e6 << setw(19) << locked / 1e6 << endl;
+			cout.unsetf(ios::fixed);
+		}
+	}
+	return EXIT_SUCCESS;
+}
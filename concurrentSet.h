@@ -0,0 +1,637 @@
+#ifndef CONCURRENTSET_H
+#define CONCURRENTSET_H
+//--------------------------------------------------------------------
+// A lock-free concurrent ordered set
+//--------------------------------------------------------------------
+#include <atomic>
+#include <new>
+#include <cstdint>
+#include "bst.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Epoch Reclaimer
+	// Class:		epochReclaimer
+	//
+	// File:		concurrentSet.h
+	// Title:		epoch-based memory reclamation
+	// Description: Defers freeing memory that lock-free readers may still
+	//				be looking at.  Every operation runs inside a guard,
+	//				which publishes the global epoch it started in.  Memory
+	//				retired during epoch e is freed once the global epoch
+	//				reaches e + 2; the epoch only advances when every
+	//				guarded thread has seen the current one, so nobody can
+	//				still hold a pointer to it by then.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class epochReclaimer:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			epochReclaimer() -- constructor
+	//			~epochReclaimer() -- frees everything still retired
+	//			guard(epochReclaimer& r) -- pins the caller's epoch
+	//			~guard() -- unpins it
+	//
+	//     non-inline:
+	//			void retire(void* p, void (*release)(void*))
+	//				-- frees p with release() once no guard can see it
+	//			void collect() -- frees whatever is old enough
+	//		protected:
+	//			bool tryAdvance() -- moves the global epoch forward
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	class epochReclaimer
+	{
+		struct slot;
+	public:
+		static const int MAX_SLOTS = 128;       // concurrent operations
+		static const int COLLECT_EVERY = 128;   // fewest retires per sweep
+
+		epochReclaimer() : m_epoch(0), m_retired(nullptr), m_retiredCount(0),
+			m_collectAt(COLLECT_EVERY), m_collecting(false)
+		{
+			for(int i = 0; i < MAX_SLOTS; i++)
+			{
+				m_slots[i].inUse.store(false);
+				m_slots[i].epoch.store(0);
+			}
+		}
+		~epochReclaimer();
+
+		class guard
+		{
+		public:
+			explicit guard(epochReclaimer& r);
+			~guard() {m_slot->inUse.store(false);}
+		private:
+			guard(const guard&);             // not copyable
+			guard& operator=(const guard&);
+			slot* m_slot;
+		};
+
+		void retire(void* p, void (*release)(void*));
+		void collect();
+
+	protected:
+		bool tryAdvance();
+
+	private:
+		struct slot
+		{
+			atomic<bool> inUse;
+			atomic<uint64_t> epoch;
+			char pad[64 - sizeof(atomic<bool>) - sizeof(atomic<uint64_t>)];
+		};
+		struct retiredItem
+		{
+			void* p;
+			void (*release)(void*);
+			uint64_t epoch;
+			retiredItem* next;
+		};
+
+		atomic<uint64_t> m_epoch;
+		slot m_slots[MAX_SLOTS];
+		atomic<retiredItem*> m_retired;    // lock-free stack
+		atomic<int> m_retiredCount;
+		atomic<int> m_collectAt;      // retired count that starts a sweep
+		atomic<bool> m_collecting;
+	};
+
+	//--------------------------------------------------------------------
+	// claims a free slot and publishes the current epoch in it
+	// spins if MAX_SLOTS operations are already in flight
+	//--------------------------------------------------------------------
+	inline epochReclaimer::guard::guard(epochReclaimer& r) : m_slot(nullptr)
+	{
+		static thread_local unsigned hint = 0;
+		for(unsigned i = hint; m_slot == nullptr; i++)
+		{
+			slot& s = r.m_slots[i % MAX_SLOTS];
+			if(!s.inUse.load(memory_order_relaxed) && !s.inUse.exchange(true))
+			{
+				m_slot = &s;
+				hint = i % MAX_SLOTS;
+			}
+		}
+		uint64_t e;
+		do
+		{
+			e = r.m_epoch.load();
+			m_slot->epoch.store(e);
+		}
+		while(r.m_epoch.load() != e);
+	}
+
+	//--------------------------------------------------------------------
+	// frees everything still on the retired list
+	// pre: no thread is inside a guard
+	//--------------------------------------------------------------------
+	inline epochReclaimer::~epochReclaimer()
+	{
+		retiredItem* item = m_retired.exchange(nullptr);
+		while(item != nullptr)
+		{
+			retiredItem* next = item->next;
+			item->release(item->p);
+			delete item;
+			item = next;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// queues p to be released once every current reader has moved on
+	// pre: p is no longer reachable from the shared structure
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline void epochReclaimer::retire(void* p, void (*release)(void*))
+	{
+		retiredItem* item = new retiredItem;
+		item->p = p;
+		item->release = release;
+		item->epoch = m_epoch.load();
+		item->next = m_retired.load();
+		while(!m_retired.compare_exchange_weak(item->next, item))
+			;
+		if(m_retiredCount.fetch_add(1) + 1 >= m_collectAt.load())
+			collect();
+	}
+
+	//--------------------------------------------------------------------
+	// moves the epoch forward if every pinned slot has seen it
+	//--------------------------------------------------------------------
+	inline bool epochReclaimer::tryAdvance()
+	{
+		uint64_t e = m_epoch.load();
+		for(int i = 0; i < MAX_SLOTS; i++)
+		{
+			if(m_slots[i].inUse.load() && m_slots[i].epoch.load() != e)
+				return false;
+		}
+		return m_epoch.compare_exchange_strong(e, e + 1);
+	}
+
+	//--------------------------------------------------------------------
+	// releases retired memory that is two epochs old
+	// only one thread sweeps at a time; the others just return.  The
+	// next sweep waits until the list has doubled, so while a stalled
+	// reader pins everything each retire still costs amortized O(1).
+	//--------------------------------------------------------------------
+	inline void epochReclaimer::collect()
+	{
+		if(m_collecting.exchange(true))
+			return;
+		tryAdvance();
+		uint64_t safe = m_epoch.load();
+		retiredItem* item = m_retired.exchange(nullptr);
+		retiredItem* keep = nullptr;
+		retiredItem* keepTail = nullptr;
+		int freed = 0;
+		while(item != nullptr)
+		{
+			retiredItem* next = item->next;
+			if(item->epoch + 2 <= safe)
+			{
+				item->release(item->p);
+				delete item;
+				freed++;
+			}
+			else
+			{
+				item->next = keep;
+				if(keep == nullptr)
+					keepTail = item;
+				keep = item;
+			}
+			item = next;
+		}
+		if(keep != nullptr)
+		{
+			keepTail->next = m_retired.load();
+			while(!m_retired.compare_exchange_weak(keepTail->next, keep))
+				;
+		}
+		int left = m_retiredCount.fetch_sub(freed) - freed;  // retire() may add meanwhile
+		m_collectAt.store(left > COLLECT_EVERY / 2 ? 2 * left : COLLECT_EVERY);
+		m_collecting.store(false);
+	}
+
+	//--------------------------------------------------------------------
+	// Concurrent Ordered Set
+	// Class:		concurrentSet<T>
+	//				REQUIRES Type T be default constructible & have
+	//				< & == defined
+	//
+	// File:		concurrentSet.h
+	// Title:		lock-free skip list
+	// Description: An ordered set that any number of threads may insert
+	//				into, erase from, search and scan at the same time with
+	//				no locks.  Each node carries a tower of next pointers
+	//				whose low bit marks the node as deleted at that level;
+	//				erase marks the tower top-down and whoever next walks
+	//				past a marked link unlinks it with a compare-and-swap.
+	//				Unlinked nodes go to an epochReclaimer.
+	//				Lookups and range scans never write and never wait.
+	//				A scan sees every key present for its whole duration
+	//				and may or may not see keys changed while it runs.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class concurrentSet<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			concurrentSet() -- default constructor
+	//			bool isempty() const -- true if no keys are present
+	//			long size() const -- number of keys (exact when quiet)
+	//
+	//     non-inline:
+	//			~concurrentSet() -- destructor
+	//			bool insert(const T& d) -- adds d; false if present
+	//			bool erase(const T& d) -- removes d; false if absent
+	//			bool contains(const T& d) -- true if d is present
+	//			void rangeScan(const T& lo, const T& hi, Visitor visit)
+	//				-- calls visit(key) for keys in [lo, hi], in order
+	//		protected:
+	//			bool find(const T& d, skipNode* preds[], skipNode* succs[])
+	//				-- locates d on every level, unlinking marked nodes
+	//			int randomHeight() -- height for a new tower
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class concurrentSet
+	{
+	public:
+		static const int MAX_HEIGHT = 24;
+
+		concurrentSet();
+		~concurrentSet();
+
+		bool isempty() const {return m_size.load() == 0;}
+		long size() const {return m_size.load();}
+		bool insert(const T& d);
+		bool erase(const T& d);
+		bool contains(const T& d);
+		template <class Visitor>
+		void rangeScan(const T& lo, const T& hi, Visitor visit);
+
+	protected:
+		struct skipNode
+		{
+			T key;
+			int height;
+			atomic<int> owners;  // inserter + eraser; last one retires
+			atomic<uintptr_t> next[1];  // really height entries
+		};
+
+		static bool isMarked(uintptr_t link) {return (link & 1) != 0;}
+		static skipNode* pointer(uintptr_t link)
+			{return reinterpret_cast<skipNode*>(link & ~uintptr_t(1));}
+		static uintptr_t link(skipNode* np)
+			{return reinterpret_cast<uintptr_t>(np);}
+		static skipNode* makeNode(const T& d, int height);
+		static void releaseNode(void* p);
+		void dropOwner(skipNode* np);
+
+		bool find(const T& d, skipNode* preds[], skipNode* succs[]);
+		int randomHeight();
+
+		skipNode* m_head;
+		atomic<long> m_size;
+		epochReclaimer m_reclaimer;
+
+	private:
+		concurrentSet(const concurrentSet<T>&);   // not copyable
+		concurrentSet<T>& operator=(const concurrentSet<T>&);
+	};
+
+	//--------------------------------------------------------------------
+	// allocates a node with room for height next pointers
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	typename concurrentSet<T>::skipNode*
+	concurrentSet<T>::makeNode(const T& d, int height)
+	{
+		size_t bytes = sizeof(skipNode)
+			+ (height - 1) * sizeof(atomic<uintptr_t>);
+		void* raw = ::operator new(bytes);
+		skipNode* np = static_cast<skipNode*>(raw);
+		try
+		{
+			new (&np->key) T(d);
+		}
+		catch(...)
+		{
+			::operator delete(raw);
+			throw;
+		}
+		np->height = height;
+		new (&np->owners) atomic<int>(2);
+		for(int i = 0; i < height; i++)
+			new (&np->next[i]) atomic<uintptr_t>(0);
+		return np;
+	}
+
+	//--------------------------------------------------------------------
+	// destroys and frees a node made by makeNode()
+	//--------------------------------------------------------------------
+	template <class T>
+	void concurrentSet<T>::releaseNode(void* p)
+	{
+		skipNode* np = static_cast<skipNode*>(p);
+		np->key.~T();
+		::operator delete(p);
+	}
+
+	//--------------------------------------------------------------------
+	// constructor -- the head tower is full height and holds no key
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	concurrentSet<T>::concurrentSet() : m_head(nullptr), m_size(0)
+	{
+		m_head = makeNode(T(), MAX_HEIGHT);
+	}
+
+	//--------------------------------------------------------------------
+	// destructor -- frees every node still linked on the bottom level
+	// pre: no other thread is using the set
+	//--------------------------------------------------------------------
+	template <class T>
+	concurrentSet<T>::~concurrentSet()
+	{
+		skipNode* np = m_head;
+		while(np != nullptr)
+		{
+			skipNode* next = pointer(np->next[0].load());
+			releaseNode(np);
+			np = next;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// returns a tower height with P(height > h) = 2^-h
+	//--------------------------------------------------------------------
+	template <class T>
+	int concurrentSet<T>::randomHeight()
+	{
+		static thread_local uint32_t state = 0;
+		if(state == 0)
+			state = static_cast<uint32_t>(
+				reinterpret_cast<uintptr_t>(&state) >> 4) | 1;
+		state ^= state << 13;    // xorshift32
+		state ^= state >> 17;
+		state ^= state << 5;
+		int height = 1;
+		for(uint32_t bits = state; (bits & 1) && height < MAX_HEIGHT;
+			bits >>= 1)
+			height++;
+		return height;
+	}
+
+	//--------------------------------------------------------------------
+	// fills preds/succs with the last node before d and the first node
+	// not before it on every level, unlinking marked nodes on the way
+	// (including a marked duplicate just behind a live one)
+	// returns true if an unmarked node holding d is on the bottom level
+	// pre: caller holds an epochReclaimer::guard
+	//--------------------------------------------------------------------
+	template <class T>
+	bool concurrentSet<T>::find(const T& d, skipNode* preds[],
+		skipNode* succs[])
+	{
+	retry:
+		skipNode* pred = m_head;
+		for(int level = MAX_HEIGHT - 1; level >= 0; level--)
+		{
+			skipNode* cur = pointer(pred->next[level].load());
+			while(cur != nullptr)
+			{
+				uintptr_t succ = cur->next[level].load();
+				while(isMarked(succ))
+				{
+					uintptr_t expected = link(cur);
+					if(!pred->next[level].compare_exchange_strong(expected,
+						link(pointer(succ))))
+						goto retry;
+					cur = pointer(succ);
+					if(cur == nullptr)
+						break;
+					succ = cur->next[level].load();
+				}
+				if(cur == nullptr || !(cur->key < d))
+					break;
+				pred = cur;
+				cur = pointer(succ);
+			}
+			while(cur != nullptr && cur->key == d)
+			{  // sweep a marked twin left behind by an erase
+				skipNode* twin = pointer(cur->next[level].load());
+				if(twin == nullptr || !(twin->key == d))
+					break;
+				uintptr_t after = twin->next[level].load();
+				if(!isMarked(after))
+					break;
+				uintptr_t expected = link(twin);
+				cur->next[level].compare_exchange_strong(expected,
+					link(pointer(after)));
+				if(isMarked(cur->next[level].load()))
+					goto retry;
+			}
+			preds[level] = pred;
+			succs[level] = cur;
+		}
+		return succs[0] != nullptr && succs[0]->key == d;
+	}
+
+	//--------------------------------------------------------------------
+	// gives up one of a node's two owners; the last one retires it
+	//--------------------------------------------------------------------
+	template <class T>
+	void concurrentSet<T>::dropOwner(skipNode* np)
+	{
+		if(np->owners.fetch_sub(1) == 1)
+			m_reclaimer.retire(np, &releaseNode);
+	}
+
+	//--------------------------------------------------------------------
+	// inserts d; the bottom-level link makes it visible, the upper
+	// levels are index only and are linked afterwards
+	// returns true if d was inserted; false if it was already present
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool concurrentSet<T>::insert(const T& d)
+	{
+		epochReclaimer::guard pin(m_reclaimer);
+		skipNode* preds[MAX_HEIGHT];
+		skipNode* succs[MAX_HEIGHT];
+		int height = randomHeight();
+		skipNode* np = nullptr;
+		while(true)
+		{
+			if(find(d, preds, succs))
+			{
+				if(np != nullptr)
+					releaseNode(np);   // never published
+				return false;
+			}
+			if(np == nullptr)
+				np = makeNode(d, height);
+			for(int level = 0; level < height; level++)
+				np->next[level].store(link(succs[level]));
+			uintptr_t expected = link(succs[0]);
+			if(preds[0]->next[0].compare_exchange_strong(expected, link(np)))
+				break;
+		}
+		m_size.fetch_add(1);
+
+		for(int level = 1; level < height; level++)
+		{
+			bool linked = false;
+			while(!linked)
+			{
+				uintptr_t mine = np->next[level].load();
+				if(isMarked(mine))
+					break;             // already being erased
+				if(pointer(mine) != succs[level]
+					&& !np->next[level].compare_exchange_strong(mine,
+						link(succs[level])))
+					continue;
+				uintptr_t expected = link(succs[level]);
+				linked = preds[level]->next[level].compare_exchange_strong(
+					expected, link(np));
+				if(!linked && (!find(d, preds, succs) || succs[0] != np))
+					break;             // erased while we were linking
+			}
+			if(!linked)
+				break;
+		}
+		if(isMarked(np->next[0].load()))
+			find(d, preds, succs);     // unlink anything we linked late
+		dropOwner(np);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// removes d: marks its tower top-down, the bottom mark being the
+	// moment of removal, then unlinks it
+	// returns true if this call removed d; false if d was absent
+	//--------------------------------------------------------------------
+	template <class T>
+	bool concurrentSet<T>::erase(const T& d)
+	{
+		epochReclaimer::guard pin(m_reclaimer);
+		skipNode* preds[MAX_HEIGHT];
+		skipNode* succs[MAX_HEIGHT];
+		if(!find(d, preds, succs))
+			return false;
+		skipNode* victim = succs[0];
+		for(int level = victim->height - 1; level > 0; level--)
+		{
+			uintptr_t succ = victim->next[level].load();
+			while(!isMarked(succ))
+				victim->next[level].compare_exchange_weak(succ, succ | 1);
+		}
+		uintptr_t succ = victim->next[0].load();
+		while(true)
+		{
+			if(isMarked(succ))
+				return false;          // another eraser won
+			if(victim->next[0].compare_exchange_strong(succ, succ | 1))
+				break;
+		}
+		m_size.fetch_sub(1);
+		find(d, preds, succs);
+		dropOwner(victim);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// returns true if d is present; never writes
+	//--------------------------------------------------------------------
+	template <class T>
+	bool concurrentSet<T>::contains(const T& d)
+	{
+		epochReclaimer::guard pin(m_reclaimer);
+		skipNode* pred = m_head;
+		skipNode* cur = nullptr;
+		for(int level = MAX_HEIGHT - 1; level >= 0; level--)
+		{
+			cur = pointer(pred->next[level].load());
+			while(cur != nullptr)
+			{
+				uintptr_t succ = cur->next[level].load();
+				if(isMarked(succ))
+				{
+					cur = pointer(succ);   // step over a deleted node
+					continue;
+				}
+				if(!(cur->key < d))
+					break;
+				pred = cur;
+				cur = pointer(succ);
+			}
+		}
+		return cur != nullptr && cur->key == d
+			&& !isMarked(cur->next[0].load());
+	}
+
+	//--------------------------------------------------------------------
+	// calls visit(key) for every present key in [lo, hi], in order
+	// visit must not call back into this set's erase
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class Visitor>
+	void concurrentSet<T>::rangeScan(const T& lo, const T& hi,
+		Visitor visit)
+	{
+		epochReclaimer::guard pin(m_reclaimer);
+		skipNode* pred = m_head;
+		for(int level = MAX_HEIGHT - 1; level >= 0; level--)
+		{
+			skipNode* cur = pointer(pred->next[level].load());
+			while(cur != nullptr && cur->key < lo)
+			{
+				pred = cur;
+				cur = pointer(cur->next[level].load());
+			}
+		}
+		skipNode* cur = pointer(pred->next[0].load());
+		while(cur != nullptr && !(hi < cur->key))
+		{
+			uintptr_t succ = cur->next[0].load();
+			if(!isMarked(succ) && !(cur->key < lo))
+				visit(cur->key);
+			cur = pointer(succ);
+		}
+	}
+
+} // end namespace AW_BST
+
+#endif
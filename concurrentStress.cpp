@@ -0,0 +1,211 @@
+//----------------------------------------------------------------------------
+// File:		concurrentStress.cpp
+//
+// Description: Stress check of concurrentSet<T>: 16 threads run mixed
+//				inserts, erases, lookups and range scans on one small key
+//				range, then on stripes of their own, and the results are
+//				checked against what the operations reported.  Build it
+//				with a sanitizer (g++/clang -fsanitize=address, or
+//				-fsanitize=thread) to check the epoch reclamation; it is
+//				most telling with as many cores as threads.
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				contend()
+//				ownStripes()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <cstdlib>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+#include "concurrentSet.h"
+using namespace std;
+
+namespace
+{
+	const int THREADS = 16;
+
+	//---------------------------------------------------------------------------
+	// Function:	contend()
+	// Title:		All threads on one key range
+	// Description: Has THREADS threads run ops operations each on keys in
+	//				[0, range): 30% inserts, 30% erases, 30% lookups, 10%
+	//				scans of up to 64 keys.  Each successful insert adds 1
+	//				to its key's tally and each successful erase takes 1
+	//				off, so afterwards every tally must be 0 or 1 and
+	//				match contains(), and the tallies must sum to size().
+	//				Every scan must come back in order and in bounds.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		concurrentSet<int>::insert(), erase(), contains(),
+	//				rangeScan(), size()
+	// Called By:	main()
+	// Parameters:	long ops; operations per thread
+	//				int range; keys are drawn from [0, range)
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int contend(long ops, int range)
+	{
+		AW_BST::concurrentSet<int> set;
+		vector<atomic<int>> tally(range);
+		for(int k = 0; k < range; k++)
+			tally[k].store(0);
+		atomic<int> badScans(0);
+		vector<thread> workers;
+		for(int t = 0; t < THREADS; t++)
+		{
+			workers.push_back(thread([&, t]()
+			{
+				mt19937 rng(static_cast<unsigned>(t) * 7919 + 1);
+				for(long i = 0; i < ops; i++)
+				{
+					int k = static_cast<int>(rng() % range);
+					unsigned op = rng() % 10;
+					if(op < 3)
+					{
+						if(set.insert(k))
+							tally[k]++;
+					}
+					else if(op < 6)
+					{
+						if(set.erase(k))
+							tally[k]--;
+					}
+					else if(op < 9)
+						set.contains(k);
+					else
+					{
+						int hi = k + static_cast<int>(rng() % 64);
+						int last = -1;
+						set.rangeScan(k, hi, [&](int key)
+						{
+							if(key < k || key > hi || key <= last)
+								badScans++;
+							last = key;
+						});
+					}
+				}
+			}));
+		}
+		for(size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+
+		int failures = badScans.load();
+		long total = 0;
+		for(int k = 0; k < range; k++)
+		{
+			int n = tally[k].load();
+			if(n < 0 || n > 1 || set.contains(k) != (n == 1))
+				failures++;
+			total += n;
+		}
+		if(set.size() != total)
+			failures++;
+		return failures;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	ownStripes()
+	// Title:		Each thread on keys of its own
+	// Description: Thread t inserts every key k < keys with k % THREADS
+	//				== t, erases the odd ones, and checks each of its keys
+	//				while the others churn theirs: inserts and erases of
+	//				its own keys must all succeed, and lookups must see
+	//				exactly the even keys.  The set must end with the even
+	//				keys, in order.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		concurrentSet<int>::insert(), erase(), contains(),
+	//				rangeScan(), size()
+	// Called By:	main()
+	// Parameters:	int keys; keys are [0, keys)
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int ownStripes(int keys)
+	{
+		AW_BST::concurrentSet<int> set;
+		atomic<int> failures(0);
+		vector<thread> workers;
+		for(int t = 0; t < THREADS; t++)
+		{
+			workers.push_back(thread([&, t]()
+			{
+				for(int k = t; k < keys; k += THREADS)
+					if(!set.insert(k))
+						failures++;
+				for(int k = t; k < keys; k += THREADS)
+					if(k % 2 == 1 && !set.erase(k))
+						failures++;
+				for(int k = t; k < keys; k += THREADS)
+					if(set.contains(k) != (k % 2 == 0))
+						failures++;
+			}));
+		}
+		for(size_t i = 0; i < workers.size(); i++)
+			workers[i].join();
+
+		int expected = 0;
+		set.rangeScan(0, keys, [&](int key)
+		{
+			if(key != expected)
+				failures++;
+			expected = key + 2;
+		});
+		if(set.size() != (keys + 1) / 2)
+			failures++;
+		return failures.load();
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		concurrentSet stress check
+// Description: Runs contend() on a small and a larger key range, then
+//				ownStripes(), and reports the failed checks
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: operations per thread (default 200000)
+// Output:		one line per run
+// Calls:		contend(), ownStripes()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS if every check passed, else EXIT_FAILURE
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	long ops = (argc > 1) ? atol(argv[1]) : 200000;
+	int failures = 0;
+	const int RANGES[] = {64, 4096};
+	for(int r = 0; r < 2; r++)
+	{
+		int bad = contend(ops, RANGES[r]);
+		cout << THREADS << " threads, " << ops << " ops each on " << RANGES[r]
+			<< " keys: " << bad << " failed checks" << endl;
+		failures += bad;
+	}
+	int bad = ownStripes(static_cast<int>(ops));
+	cout << THREADS << " threads on their own stripes of " << ops
+		<< " keys: " << bad << " failed checks" << endl;
+	failures += bad;
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
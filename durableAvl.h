@@ -0,0 +1,630 @@
+#ifndef DURABLEAVL_H
+#define DURABLEAVL_H
+//--------------------------------------------------------------------
+// An avl tree made durable by a write-ahead log
+//--------------------------------------------------------------------
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdio>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+#include "keyLoader.h"
+#include "sharedAvl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// encodeKey overloads -- write a key as the text parseKey() reads
+	// back; add an overload here to log a new key type
+	//--------------------------------------------------------------------
+	inline void encodeKey(string& out, const string& d) {out = d;}
+	inline void encodeKey(string& out, char d) {out.assign(1, d);}
+
+	template <class T>
+	typename enable_if<is_floating_point<T>::value>::type
+	encodeKey(string& out, T d)
+	{
+		char digits[64];
+		snprintf(digits, sizeof(digits), "%.*g",
+			numeric_limits<T>::max_digits10, static_cast<double>(d));
+		out = digits;
+	}
+
+	template <class T>
+	typename enable_if<is_integral<T>::value && !is_same<T, char>::value>::type
+	encodeKey(string& out, T d)
+	{
+		out = to_string(d);
+	}
+
+	template <class T>
+	typename enable_if<!is_arithmetic<T>::value>::type
+	encodeKey(string& out, const T& d)
+	{
+		ostringstream text;
+		text << d;
+		out = text.str();
+	}
+
+	//--------------------------------------------------------------------
+	// appends one record: op, key length, ':', key bytes, '\n'
+	// the length prefix lets keys hold any byte, newlines included
+	//--------------------------------------------------------------------
+	inline void appendRecord(string& out, char op, const string& key)
+	{
+		out += op;
+		out += to_string(key.size());
+		out += ':';
+		out += key;
+		out += '\n';
+	}
+
+	//--------------------------------------------------------------------
+	// reads the record at cur and steps past it
+	// returns false, leaving cur alone, on a torn or corrupt record
+	//--------------------------------------------------------------------
+	inline bool parseRecord(const char*& cur, const char* end, char& op,
+		const char*& keyFirst, const char*& keyLast)
+	{
+		const char* p = cur;
+		if(p == end || (*p != '+' && *p != '-'))
+			return false;
+		char kind = *p++;
+		const char* digits = p;
+		size_t length = 0;
+		for(; p != end && *p >= '0' && *p <= '9'; ++p)
+		{
+			length = length * 10 + static_cast<size_t>(*p - '0');
+			if(length > static_cast<size_t>(end - cur))
+				return false;
+		}
+		if(p == digits || p == end || *p != ':')
+			return false;
+		++p;
+		if(static_cast<size_t>(end - p) <= length || p[length] != '\n')
+			return false;
+		op = kind;
+		keyFirst = p;
+		keyLast = p + length;
+		cur = keyLast + 1;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// reads a whole file; returns false if it cannot be opened
+	//--------------------------------------------------------------------
+	inline bool readFile(const string& fileName, string& contents)
+	{
+		ifstream in(fileName.c_str(), ios::in | ios::binary);
+		if(!in)
+			return false;
+		in.seekg(0, ios::end);
+		streamoff length = in.tellg();
+		in.seekg(0, ios::beg);
+		contents.resize(static_cast<size_t>((length > 0) ? length : 0));
+		if(!contents.empty())
+			in.read(&contents[0], static_cast<streamsize>(contents.size()));
+		contents.resize(static_cast<size_t>(in.gcount() > 0 ? in.gcount() : 0));
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// pushes everything written to f through to the disk
+	//--------------------------------------------------------------------
+	inline bool syncFile(FILE* f)
+	{
+		if(fflush(f) != 0)
+			return false;
+#ifdef _WIN32
+		return _commit(_fileno(f)) == 0;
+#else
+		return fsync(fileno(f)) == 0;
+#endif
+	}
+
+	//--------------------------------------------------------------------
+	// Durable AVL Tree
+	// Class:		durableAvl<T>
+	//				REQUIRES Type T meet sharedAvl<T>'s requirements, and
+	//				have encodeKey() and parseKey() defined
+	//
+	// File:		durableAvl.h
+	// Title:		durableAvl template Class; wraps a sharedAvl<T>
+	// Description: Keeps a sharedAvl<T> in memory and records every insert and
+	//				erase that changes it in an append-only log.  Writers
+	//				only append the record to a buffer; a background thread
+	//				writes whatever has piled up and fsyncs it as one group,
+	//				so many writers share each fsync.  sync() waits until
+	//				everything written so far is on disk.
+	//
+	//				Once the log passes snapshotBytes the thread cuts over
+	//				to a new log generation, writes every key to a snapshot
+	//				file tagged with that generation, and deletes the older
+	//				logs.  Writers are held off only to swap out the queued
+	//				records and take an O(1) copy of the tree; the file
+	//				work happens after, on the copy, while writers clone
+	//				the few nodes they change.  On construction the
+	//				snapshot is bulk built into the tree and the logs from
+	//				its generation on are replayed, each up to its first
+	//				torn record.
+	//
+	//				Files: <base>.snap, <base>.snap.tmp, <base>.log.<gen>
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class durableAvl<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			bool contains(const T& d) const -- true if d is in the tree
+	//			size_t size() const -- number of keys
+	//			size_t recoveredRecords() const -- log records replayed
+	//			void print(ostream& out) const -- prints the tree inorder
+	//
+	//     non-inline:
+	//			durableAvl(const string& baseName, size_t snapshotBytes)
+	//				-- recovers the tree and starts the log thread
+	//			~durableAvl() -- writes out the log and stops the thread
+	//			bool insert(const T& d) -- adds d and logs it
+	//			bool erase(const T& d) -- removes d and logs it
+	//			void sync() -- waits until every change so far is durable
+	//			void snapshot() -- writes a snapshot now and waits for it
+	//		private:
+	//			void append(char op, const string& key)
+	//				-- queues a record for the log thread
+	//			void recover() -- rebuilds the tree from disk
+	//			bool loadSnapshot(const string& fileName)
+	//				-- bulk builds the tree from a complete snapshot
+	//			bool replayLog(const string& fileName)
+	//				-- applies a log's records to the tree
+	//			bool writeBatch(const string& batch)
+	//				-- writes and fsyncs records to the current log
+	//			void commitLoop() -- the log thread
+	//			bool compact() -- starts a new log and writes a snapshot
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class durableAvl
+	{
+	public:
+		static const size_t SNAPSHOT_BYTES = 64 << 20;
+
+		explicit durableAvl(const string& baseName,
+			size_t snapshotBytes = SNAPSHOT_BYTES);
+		~durableAvl();
+
+		bool insert(const T& d);
+		bool erase(const T& d);
+		bool contains(const T& d) const
+			{lock_guard<mutex> lock(m_treeLock); return m_tree.contains(d);}
+		size_t size() const
+			{lock_guard<mutex> lock(m_treeLock); return m_tree.size();}
+		void sync();
+		void snapshot();
+		size_t recoveredRecords() const {return m_recovered;}
+		void print(ostream& out) const
+			{lock_guard<mutex> lock(m_treeLock); m_tree.print(out);}
+
+	private:
+		durableAvl(const durableAvl<T>&);              // not copyable
+		durableAvl<T>& operator=(const durableAvl<T>&);
+
+		string logName(unsigned long long generation) const
+			{return m_base + ".log." + to_string(generation);}
+		bool openLog()
+		{
+			m_log = fopen(logName(m_generation).c_str(), "ab");
+			return m_log != nullptr;
+		}
+		void append(char op, const string& key);
+		void recover();
+		bool loadSnapshot(const string& fileName);
+		bool replayLog(const string& fileName);
+		bool writeBatch(const string& batch);
+		void commitLoop();
+		bool compact();
+
+		sharedAvl<T> m_tree;
+		mutable mutex m_treeLock;     // taken before m_logLock
+		string m_base;
+		size_t m_snapshotBytes;
+		size_t m_recovered;
+
+		// owned by the log thread once it is running
+		FILE* m_log;
+		unsigned long long m_generation;
+		unsigned long long m_oldestLog;   // first log still on disk
+		size_t m_logBytes;
+
+		// guarded by m_logLock
+		mutex m_logLock;
+		condition_variable m_wake;     // log thread: work to do
+		condition_variable m_synced;   // waiters: progress was made
+		string m_pending;
+		unsigned long long m_appended; // records queued so far
+		unsigned long long m_durable;  // records known to be on disk
+		unsigned long long m_snapshots;
+		bool m_snapshotWanted;
+		bool m_compacting;
+		bool m_stopping;
+		atomic<bool> m_failed;
+
+		thread m_committer;
+	};
+
+	template <class T>
+	const size_t durableAvl<T>::SNAPSHOT_BYTES;
+
+	//--------------------------------------------------------------------
+	// recovers the tree from baseName's files and starts the log thread
+	// throws invalid_argument if the log cannot be opened, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	durableAvl<T>::durableAvl(const string& baseName, size_t snapshotBytes)
+		: m_base(baseName), m_snapshotBytes(snapshotBytes), m_recovered(0),
+		m_log(nullptr), m_generation(0), m_oldestLog(0), m_logBytes(0),
+		m_appended(0),
+		m_durable(0), m_snapshots(0), m_snapshotWanted(false),
+		m_compacting(false), m_stopping(false), m_failed(false)
+	{
+		recover();
+		if(!openLog())
+			throw (invalid_argument("Could not open log file "
+				+ logName(m_generation)));
+		m_committer = thread(&durableAvl<T>::commitLoop, this);
+	}
+
+	//--------------------------------------------------------------------
+	// lets the log thread write out what is queued, then stops it
+	//--------------------------------------------------------------------
+	template <class T>
+	durableAvl<T>::~durableAvl()
+	{
+		{
+			lock_guard<mutex> lock(m_logLock);
+			m_stopping = true;
+		}
+		m_wake.notify_one();
+		m_committer.join();
+		if(m_log != nullptr)
+			fclose(m_log);
+	}
+
+	//--------------------------------------------------------------------
+	// inserts d; the record is queued, not yet durable
+	// returns true if d was inserted; false if it was already present
+	// throws runtime_error once the log has failed, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::insert(const T& d)
+	{
+		string key;
+		encodeKey(key, d);
+		lock_guard<mutex> lock(m_treeLock);
+		if(m_failed)
+			throw (runtime_error("Write-ahead log failed"));
+		if(!m_tree.insert(d))
+			return false;
+		append('+', key);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// erases d; the record is queued, not yet durable
+	// returns true if d was found and removed
+	// throws runtime_error once the log has failed, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::erase(const T& d)
+	{
+		string key;
+		encodeKey(key, d);
+		lock_guard<mutex> lock(m_treeLock);
+		if(m_failed)
+			throw (runtime_error("Write-ahead log failed"));
+		if(!m_tree.erase(d))
+			return false;
+		append('-', key);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// queues a record for the log thread
+	// pre: the caller holds m_treeLock, so records keep the tree's order
+	//--------------------------------------------------------------------
+	template <class T>
+	void durableAvl<T>::append(char op, const string& key)
+	{
+		{
+			lock_guard<mutex> lock(m_logLock);
+			appendRecord(m_pending, op, key);
+			m_appended++;
+		}
+		m_wake.notify_one();
+	}
+
+	//--------------------------------------------------------------------
+	// waits until every record queued before the call is on disk
+	// throws runtime_error if the log has failed
+	//--------------------------------------------------------------------
+	template <class T>
+	void durableAvl<T>::sync()
+	{
+		unique_lock<mutex> lock(m_logLock);
+		unsigned long long target = m_appended;
+		m_synced.wait(lock, [this, target]
+			{return m_durable >= target || m_failed;});
+		if(m_failed)
+			throw (runtime_error("Write-ahead log failed"));
+	}
+
+	//--------------------------------------------------------------------
+	// has the log thread write a snapshot of the current tree, and waits
+	// throws runtime_error if the log has failed
+	//--------------------------------------------------------------------
+	template <class T>
+	void durableAvl<T>::snapshot()
+	{
+		unique_lock<mutex> lock(m_logLock);
+		// one already under way may have copied the tree before this call
+		unsigned long long target = m_snapshots + (m_compacting ? 2 : 1);
+		m_snapshotWanted = true;
+		m_wake.notify_one();
+		m_synced.wait(lock, [this, target]
+			{return m_snapshots >= target || m_failed;});
+		if(m_failed)
+			throw (runtime_error("Write-ahead log failed"));
+	}
+
+	//--------------------------------------------------------------------
+	// loads the newest complete snapshot, drops the logs it covers and
+	// replays the rest; picks the log generation to continue in
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void durableAvl<T>::recover()
+	{
+		string snapName = m_base + ".snap";
+		string tmpName = m_base + ".snap.tmp";
+		if(!loadSnapshot(snapName) && loadSnapshot(tmpName))
+		{   // crashed between dropping the old snapshot and the rename
+			remove(snapName.c_str());
+			rename(tmpName.c_str(), snapName.c_str());
+		}
+		// compact() deletes oldest first, so leftovers run up to here
+		for(unsigned long long g = m_generation;
+			g-- > 0 && remove(logName(g).c_str()) == 0; )
+			;
+		m_oldestLog = m_generation;
+		while(replayLog(logName(m_generation)))
+			m_generation++;    // a torn log is never appended to again
+	}
+
+	//--------------------------------------------------------------------
+	// bulk builds the tree from a snapshot and takes its generation
+	// returns false, leaving the tree empty, if the file is missing or
+	// incomplete
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::loadSnapshot(const string& fileName)
+	{
+		const string HEADER = "AWSNAP ";
+		const string TRAILER = "end\n";
+		string contents;
+		if(!readFile(fileName, contents)
+			|| contents.compare(0, HEADER.size(), HEADER) != 0)
+			return false;
+		const char* cur = contents.data() + HEADER.size();
+		const char* end = contents.data() + contents.size();
+		unsigned long long generation = 0;
+		for(; cur != end && *cur >= '0' && *cur <= '9'; ++cur)
+			generation = generation * 10 + static_cast<unsigned>(*cur - '0');
+		if(cur == end || *cur++ != '\n')
+			return false;
+
+		vector<T> keys;
+		T key = T();
+		char op = 0;
+		const char* keyFirst = nullptr;
+		const char* keyLast = nullptr;
+		while(parseRecord(cur, end, op, keyFirst, keyLast))
+		{
+			if(op != '+' || !parseKey(keyFirst, keyLast, key))
+				return false;
+			keys.push_back(key);
+		}
+		if(static_cast<size_t>(end - cur) != TRAILER.size()
+			|| TRAILER.compare(0, TRAILER.size(), cur, TRAILER.size()) != 0)
+			return false;
+		m_tree.bulkInsert(keys.begin(), keys.end());
+		m_generation = generation;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// applies a log's records in order, up to the first bad one; runs of
+	// inserts go in as one batch
+	// returns false if the file does not exist
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::replayLog(const string& fileName)
+	{
+		string contents;
+		if(!readFile(fileName, contents))
+			return false;
+		const char* cur = contents.data();
+		const char* end = contents.data() + contents.size();
+		vector<T> batch;
+		T key = T();
+		char op = 0;
+		const char* keyFirst = nullptr;
+		const char* keyLast = nullptr;
+		while(parseRecord(cur, end, op, keyFirst, keyLast)
+			&& parseKey(keyFirst, keyLast, key))
+		{
+			m_recovered++;
+			if(op == '+')
+			{
+				batch.push_back(key);
+				continue;
+			}
+			m_tree.bulkInsert(batch.begin(), batch.end());
+			batch.clear();
+			m_tree.erase(key);
+		}
+		m_tree.bulkInsert(batch.begin(), batch.end());
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// writes records to the current log and waits for the disk
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::writeBatch(const string& batch)
+	{
+		if(batch.empty())
+			return true;
+		return fwrite(batch.data(), 1, batch.size(), m_log) == batch.size()
+			&& syncFile(m_log);
+	}
+
+	//--------------------------------------------------------------------
+	// the log thread: writes out each group of queued records with one
+	// fsync, and compacts when asked or when the log grows too long
+	//--------------------------------------------------------------------
+	template <class T>
+	void durableAvl<T>::commitLoop()
+	{
+		unique_lock<mutex> lock(m_logLock);
+		while(true)
+		{
+			m_wake.wait(lock, [this]
+				{return m_stopping || m_snapshotWanted || !m_pending.empty();});
+			bool ok = true;
+			if(!m_pending.empty())
+			{   // everything queued during the last fsync goes as one group
+				string batch;
+				batch.swap(m_pending);
+				unsigned long long upTo = m_appended;
+				lock.unlock();
+				ok = writeBatch(batch);
+				lock.lock();
+				if(ok)
+				{
+					m_durable = upTo;
+					m_logBytes += batch.size();
+					if(m_logBytes >= m_snapshotBytes)
+						m_snapshotWanted = true;
+				}
+			}
+			else if(m_snapshotWanted)
+			{
+				m_snapshotWanted = false;
+				m_compacting = true;
+				lock.unlock();
+				ok = compact();
+				lock.lock();
+				m_compacting = false;
+				m_snapshots++;
+			}
+			else
+				return;    // stopping, and nothing is left to write
+			if(!ok)
+				m_failed = true;
+			m_synced.notify_all();
+			if(!ok)
+				return;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// cuts the log over to a new generation: while writers are held off
+	// only takes the queued records and a copy of the tree that shares
+	// its nodes, then writes the records to the old log, opens the new
+	// one, writes the copy's keys as the snapshot for the new generation
+	// and deletes the logs it replaces
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool durableAvl<T>::compact()
+	{
+		sharedAvl<T> keys;
+		string batch;
+		unsigned long long upTo = 0;
+		unsigned long long generation = 0;
+		{
+			lock_guard<mutex> treeLock(m_treeLock);
+			lock_guard<mutex> lock(m_logLock);
+			batch.swap(m_pending);
+			upTo = m_appended;
+			generation = ++m_generation;
+			keys = m_tree;    // O(1)
+		}
+		// records queued from here on wait in m_pending for the new log
+		if(!writeBatch(batch))
+			return false;
+		fclose(m_log);
+		if(!openLog())
+			return false;
+		{
+			lock_guard<mutex> lock(m_logLock);
+			m_durable = upTo;
+			m_logBytes = 0;
+		}
+		m_synced.notify_all();
+
+		string tmpName = m_base + ".snap.tmp";
+		string snapName = m_base + ".snap";
+		FILE* out = fopen(tmpName.c_str(), "wb");
+		if(out == nullptr)
+			return false;
+		string text = "AWSNAP " + to_string(generation) + "\n";
+		string key;
+		bool ok = true;
+		keys.forEach([&](const T& d)
+		{
+			encodeKey(key, d);
+			appendRecord(text, '+', key);
+			if(text.size() >= LOAD_CHUNK_SIZE)
+			{
+				ok = fwrite(text.data(), 1, text.size(), out) == text.size()
+					&& ok;
+				text.clear();
+			}
+		});
+		keys.delTree();    // writers stop cloning the nodes it shared
+		text += "end\n";
+		ok = ok && fwrite(text.data(), 1, text.size(), out) == text.size()
+			&& syncFile(out);
+		ok = (fclose(out) == 0) && ok;
+		if(!ok)
+			return false;
+		remove(snapName.c_str());
+		if(rename(tmpName.c_str(), snapName.c_str()) != 0)
+			return false;
+		for(; m_oldestLog < generation; m_oldestLog++)
+			remove(logName(m_oldestLog).c_str());
+		return true;
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -0,0 +1,407 @@
+//----------------------------------------------------------------------------
+// File:		durableRecovery.cpp
+//
+// Description: Recovery check of durableAvl<T>: builds the file states a
+//				crash can leave behind -- a log with a torn last record, a
+//				complete snapshot left under its .snap.tmp name with no
+//				.snap, and stale logs older than the snapshot -- then
+//				reopens the tree and checks what it recovered and which
+//				files it left.  Pass a base name in a scratch directory;
+//				files starting with it are deleted.
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				clearFiles()
+//				fileExists()
+//				appendFile()
+//				snapshotGeneration()
+//				expectKeys()
+//				tornTail()
+//				tmpSnapshot()
+//				staleLogs()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <set>
+#include <string>
+#include "durableAvl.h"
+using namespace std;
+
+namespace
+{
+	const unsigned long long MAX_LOGS = 64;   // generations clearFiles() sweeps
+	const int KEYS = 1000;
+
+	//---------------------------------------------------------------------------
+	// Function:	clearFiles()
+	// Title:		Deletes a tree's files
+	// Description: Removes <base>.snap, <base>.snap.tmp and the logs of the
+	//				first MAX_LOGS generations
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		n/a
+	// Called By:	tornTail(), tmpSnapshot(), staleLogs()
+	// Parameters:	const string& base; the tree's base name
+	// Returns:		void
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	void clearFiles(const string& base)
+	{
+		remove((base + ".snap").c_str());
+		remove((base + ".snap.tmp").c_str());
+		for(unsigned long long g = 0; g < MAX_LOGS; g++)
+			remove((base + ".log." + to_string(g)).c_str());
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	fileExists()
+	// Title:		Checks for a file
+	// Description: Tries to open fileName for reading
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		n/a
+	// Called By:	tmpSnapshot(), staleLogs()
+	// Parameters:	const string& fileName; file to look for
+	// Returns:		true if it exists
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	bool fileExists(const string& fileName)
+	{
+		FILE* f = fopen(fileName.c_str(), "rb");
+		if(f == nullptr)
+			return false;
+		fclose(f);
+		return true;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	appendFile()
+	// Title:		Appends raw bytes to a file
+	// Description: Opens fileName for appending, creating it if needed,
+	//				and writes text as it is
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		n/a
+	// Called By:	tornTail(), staleLogs()
+	// Parameters:	const string& fileName; file to write
+	//				const string& text; bytes to append
+	// Returns:		true if every byte was written
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	bool appendFile(const string& fileName, const string& text)
+	{
+		FILE* f = fopen(fileName.c_str(), "ab");
+		if(f == nullptr)
+			return false;
+		bool written = fwrite(text.data(), 1, text.size(), f) == text.size();
+		return fclose(f) == 0 && written;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	snapshotGeneration()
+	// Title:		Reads a snapshot's generation
+	// Description: Reads the number after "AWSNAP " on the first line
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		readFile()
+	// Called By:	staleLogs()
+	// Parameters:	const string& fileName; the snapshot
+	// Returns:		the generation, or 0 if the file cannot be read
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	unsigned long long snapshotGeneration(const string& fileName)
+	{
+		string contents;
+		if(!AW_BST::readFile(fileName, contents) || contents.size() < 7)
+			return 0;
+		return strtoull(contents.c_str() + 7, nullptr, 10);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	expectKeys()
+	// Title:		Compares a recovered tree with the keys it should hold
+	// Description: Checks the size and every key in [-1, range], and
+	//				prints what differs under label
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		durableAvl<int>::size(), contains()
+	// Called By:	tornTail(), tmpSnapshot(), staleLogs()
+	// Parameters:	const durableAvl<int>& tree; the recovered tree
+	//				const set<int>& keys; what it should hold
+	//				int range; largest key worth probing
+	//				const string& label; names the check in the output
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int expectKeys(const AW_BST::durableAvl<int>& tree, const set<int>& keys,
+		int range, const string& label)
+	{
+		int failures = 0;
+		if(tree.size() != keys.size())
+		{
+			cout << label << ": " << tree.size() << " keys, expected "
+				<< keys.size() << endl;
+			failures++;
+		}
+		for(int k = -1; k <= range; k++)
+		{
+			if(tree.contains(k) != (keys.count(k) != 0))
+			{
+				cout << label << ": key " << k << " wrongly "
+					<< (tree.contains(k) ? "present" : "missing") << endl;
+				failures++;
+			}
+		}
+		return failures;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	tornTail()
+	// Title:		A log whose last record was cut off
+	// Description: Logs KEYS inserts, then appends half a record to the
+	//				log as a crash mid-write would.  Reopening must replay
+	//				every whole record and drop the torn one.  A key
+	//				inserted after that must survive a second reopen, so
+	//				new records cannot have gone after the torn bytes.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		clearFiles(), appendFile(), expectKeys(),
+	//				durableAvl<int>::insert(), sync(), recoveredRecords()
+	// Called By:	main()
+	// Parameters:	const string& base; base name for the files
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int tornTail(const string& base)
+	{
+		clearFiles(base);
+		set<int> keys;
+		{
+			AW_BST::durableAvl<int> tree(base);
+			for(int k = 0; k < KEYS; k++)
+			{
+				tree.insert(k);
+				keys.insert(k);
+			}
+			tree.sync();
+		}
+		int failures = 0;
+		if(!appendFile(base + ".log.0", "+4:12"))
+		{
+			cout << "torn tail: could not write the log" << endl;
+			return 1;
+		}
+		{
+			AW_BST::durableAvl<int> tree(base);
+			failures += expectKeys(tree, keys, KEYS + 1, "torn tail");
+			if(tree.recoveredRecords() != static_cast<size_t>(KEYS))
+			{
+				cout << "torn tail: replayed " << tree.recoveredRecords()
+					<< " records, expected " << KEYS << endl;
+				failures++;
+			}
+			tree.insert(KEYS);
+			keys.insert(KEYS);
+		}
+		AW_BST::durableAvl<int> tree(base);
+		failures += expectKeys(tree, keys, KEYS + 1, "after the torn tail");
+		clearFiles(base);
+		return failures;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	tmpSnapshot()
+	// Title:		A complete snapshot left under its temporary name
+	// Description: Takes a snapshot, logs more changes, then renames
+	//				<base>.snap to <base>.snap.tmp, the state of a crash
+	//				after the old snapshot was dropped and before the new
+	//				one was renamed into place.  Reopening must load the
+	//				.tmp file, replay the later log, and leave the
+	//				snapshot under its proper name.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		clearFiles(), fileExists(), expectKeys(),
+	//				durableAvl<int>::insert(), erase(), snapshot(), sync()
+	// Called By:	main()
+	// Parameters:	const string& base; base name for the files
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int tmpSnapshot(const string& base)
+	{
+		clearFiles(base);
+		set<int> keys;
+		{
+			AW_BST::durableAvl<int> tree(base);
+			for(int k = 0; k < KEYS; k++)
+			{
+				tree.insert(k);
+				keys.insert(k);
+			}
+			tree.snapshot();
+			for(int k = 0; k < KEYS; k += 3)
+			{
+				tree.erase(k);
+				keys.erase(k);
+			}
+			tree.sync();
+		}
+		string snapName = base + ".snap";
+		string tmpName = base + ".snap.tmp";
+		if(rename(snapName.c_str(), tmpName.c_str()) != 0)
+		{
+			cout << "snap.tmp: no snapshot was written" << endl;
+			return 1;
+		}
+		int failures = 0;
+		{
+			AW_BST::durableAvl<int> tree(base);
+			failures += expectKeys(tree, keys, KEYS, "snap.tmp");
+		}
+		if(!fileExists(snapName) || fileExists(tmpName))
+		{
+			cout << "snap.tmp: the snapshot was not renamed into place"
+				<< endl;
+			failures++;
+		}
+		AW_BST::durableAvl<int> tree(base);
+		failures += expectKeys(tree, keys, KEYS, "after snap.tmp");
+		clearFiles(base);
+		return failures;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	staleLogs()
+	// Title:		Logs older than the snapshot
+	// Description: Takes two snapshots, then writes logs for the
+	//				generations below the snapshot's, as a crash while
+	//				deleting them would leave, holding records that would
+	//				change the tree.  Reopening must ignore and delete
+	//				them.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		clearFiles(), fileExists(), appendFile(),
+	//				snapshotGeneration(), expectKeys(), appendRecord(),
+	//				durableAvl<int>::insert(), snapshot()
+	// Called By:	main()
+	// Parameters:	const string& base; base name for the files
+	// Returns:		the number of failed checks
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	int staleLogs(const string& base)
+	{
+		clearFiles(base);
+		set<int> keys;
+		{
+			AW_BST::durableAvl<int> tree(base);
+			for(int k = 0; k < KEYS; k++)
+			{
+				tree.insert(k);
+				keys.insert(k);
+			}
+			tree.snapshot();
+			tree.insert(KEYS);
+			keys.insert(KEYS);
+			tree.snapshot();
+		}
+		unsigned long long generation = snapshotGeneration(base + ".snap");
+		if(generation == 0)
+		{
+			cout << "stale logs: no snapshot generation to go below" << endl;
+			return 1;
+		}
+		string stale;
+		AW_BST::appendRecord(stale, '+', "-1");
+		AW_BST::appendRecord(stale, '-', "0");
+		AW_BST::appendRecord(stale, '+', to_string(KEYS + 1));
+		for(unsigned long long g = 0; g < generation; g++)
+		{
+			if(!appendFile(base + ".log." + to_string(g), stale))
+			{
+				cout << "stale logs: could not write a log" << endl;
+				return 1;
+			}
+		}
+		int failures = 0;
+		{
+			AW_BST::durableAvl<int> tree(base);
+			failures += expectKeys(tree, keys, KEYS + 1, "stale logs");
+		}
+		for(unsigned long long g = 0; g < generation; g++)
+		{
+			if(fileExists(base + ".log." + to_string(g)))
+			{
+				cout << "stale logs: log " << g << " was not deleted" << endl;
+				failures++;
+			}
+		}
+		clearFiles(base);
+		return failures;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		durableAvl recovery check
+// Description: Runs each crash state and reports the failed checks
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: base name for the files (default
+//				durableRecovery.tmp in the current directory)
+// Output:		one line per crash state
+// Calls:		tornTail(), tmpSnapshot(), staleLogs()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS if every check passed, else EXIT_FAILURE
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	string base = (argc > 1) ? argv[1] : "durableRecovery.tmp";
+	int failures = 0;
+	int bad = tornTail(base);
+	cout << "torn log tail: " << bad << " failed checks" << endl;
+	failures += bad;
+	bad = tmpSnapshot(base);
+	cout << "snapshot only in snap.tmp: " << bad << " failed checks" << endl;
+	failures += bad;
+	bad = staleLogs(base);
+	cout << "logs older than the snapshot: " << bad << " failed checks"
+		<< endl;
+	failures += bad;
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,342 @@
+#ifndef EXPIRYINDEX_H
+#define EXPIRYINDEX_H
+//--------------------------------------------------------------------
+// Keys with deadlines, evicted in bulk once they expire
+//--------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Expiry Index
+	// Class:		expiryIndex<K, Clock>
+	//				REQUIRES Type K be default constructible & have
+	//				< & == defined; Clock a std::chrono clock,
+	//				steady_clock by default
+	//
+	// File:		expiryIndex.h
+	// Title:		expiryIndex template Class
+	// Description: A set of keys, each with a deadline, kept in two avl
+	//				trees: one by key for lookups and one by deadline.
+	//				Evicting every key whose deadline has passed splits
+	//				the expired prefix off the deadline tree in O(log n),
+	//				then unlinks those e keys from the key tree in one
+	//				join-based pass, O(e log(n / e + 1)).  Nothing is
+	//				allocated but the list of keys, and every node is
+	//				freed after the lock is released.  A limit on the
+	//				batch bounds each pause, and startReaper() runs the
+	//				eviction in batches on a background thread.
+	//
+	//				A key is live while now < its deadline.  Lookups treat
+	//				an expired key as gone even before it is evicted;
+	//				size() counts it until then.  Every method is thread
+	//				safe.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class expiryIndex<K, Clock>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			expiryIndex() -- default constructor
+	//			~expiryIndex() -- stops the reaper
+	//			bool insert(const K& k, duration ttl) -- adds k, or
+	//				moves its deadline, to ttl from now
+	//			bool contains(const K& k) const -- true if k is live
+	//			size_t size() const -- keys not yet evicted
+	//			size_t evicted() const -- keys evicted so far
+	//
+	//     non-inline:
+	//			bool insertUntil(const K& k, time_point deadline)
+	//				-- adds k, or moves its deadline
+	//			bool erase(const K& k) -- removes k
+	//			time_point deadline(const K& k) const -- k's deadline
+	//			time_point nextDeadline() const -- the earliest deadline
+	//			size_t evictExpired(time_point now, size_t limit,
+	//				vector<K>* keys) -- evicts up to limit expired keys
+	//			void startReaper(duration interval, size_t batch)
+	//				-- evicts on a background thread
+	//			void stopReaper() -- stops the background thread
+	//		private:
+	//			void reapLoop() -- the reaper thread
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class K, class Clock = chrono::steady_clock>
+	class expiryIndex
+	{
+	public:
+		typedef typename Clock::time_point time_point;
+		typedef typename Clock::duration duration;
+		static const size_t REAP_BATCH = 4096;   // keys per reaper pause
+
+		expiryIndex() : m_evicted(0), m_stopping(false) {}
+		~expiryIndex() {stopReaper();}
+
+		bool insert(const K& k, duration ttl)
+			{return insertUntil(k, Clock::now() + ttl);}
+		bool insertUntil(const K& k, time_point deadline);
+		bool erase(const K& k);
+		bool contains(const K& k) const
+		{
+			time_point now = Clock::now();
+			lock_guard<mutex> lock(m_lock);
+			const node<keyEntry>* np = m_byKey.find(keyEntry(k));
+			return np != nullptr && now < np->value().deadline;
+		}
+		time_point deadline(const K& k) const;
+		time_point nextDeadline() const;
+		size_t size() const
+			{lock_guard<mutex> lock(m_lock); return m_byKey.size();}
+		size_t evicted() const
+			{lock_guard<mutex> lock(m_lock); return m_evicted;}
+		size_t evictExpired(time_point now = Clock::now(),
+			size_t limit = static_cast<size_t>(-1), vector<K>* keys = nullptr);
+		void startReaper(duration interval, size_t batch = REAP_BATCH);
+		void stopReaper();
+
+	private:
+		struct keyEntry    // ordered by key alone
+		{
+			keyEntry(const K& k = K(), time_point d = time_point())
+				: key(k), deadline(d) {}
+			bool operator<(const keyEntry& e) const {return key < e.key;}
+			bool operator==(const keyEntry& e) const {return key == e.key;}
+			K key;
+			time_point deadline;
+		};
+		struct deadlineEntry    // ordered by deadline, then key
+		{
+			deadlineEntry(time_point d = time_point(), const K& k = K(),
+				bool probe = false) : deadline(d), key(k), last(probe) {}
+			bool operator<(const deadlineEntry& e) const
+			{
+				if(deadline != e.deadline)
+					return deadline < e.deadline;
+				if(last != e.last)
+					return e.last;
+				return key < e.key;
+			}
+			bool operator==(const deadlineEntry& e) const
+				{return deadline == e.deadline && last == e.last
+				&& key == e.key;}
+			time_point deadline;
+			K key;
+			bool last;   // a probe that sorts after every key at deadline
+		};
+
+		expiryIndex(const expiryIndex<K, Clock>&);         // not copyable
+		expiryIndex<K, Clock>& operator=(const expiryIndex<K, Clock>&);
+
+		void reapLoop(duration interval, size_t batch);
+
+		avl<keyEntry> m_byKey;
+		avl<deadlineEntry> m_byDeadline;
+		mutable mutex m_lock;
+		size_t m_evicted;
+
+		// the reaper thread, guarded by m_lock
+		thread m_reaper;
+		condition_variable m_wake;
+		bool m_stopping;
+	};
+
+	template <class K, class Clock>
+	const size_t expiryIndex<K, Clock>::REAP_BATCH;
+
+	//--------------------------------------------------------------------
+	// adds k to expire at deadline, or moves the deadline of a k that is
+	// already present
+	// returns true if k was not present
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	bool expiryIndex<K, Clock>::insertUntil(const K& k, time_point deadline)
+	{
+		lock_guard<mutex> lock(m_lock);
+		node<keyEntry>* np = m_byKey.find(keyEntry(k));
+		if(np == nullptr)
+		{
+			m_byDeadline.insert(deadlineEntry(deadline, k));
+			try
+			{
+				m_byKey.insert(keyEntry(k, deadline));
+			}
+			catch(...)
+			{
+				m_byDeadline.erase(deadlineEntry(deadline, k));
+				throw;
+			}
+			return true;
+		}
+		if(np->value().deadline != deadline)
+		{
+			m_byDeadline.insert(deadlineEntry(deadline, k));
+			m_byDeadline.erase(deadlineEntry(np->value().deadline, k));
+			np->setdata(keyEntry(k, deadline));  // same key, same place
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------------
+	// removes k, expired or not
+	// returns false if k is not present
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	bool expiryIndex<K, Clock>::erase(const K& k)
+	{
+		lock_guard<mutex> lock(m_lock);
+		const node<keyEntry>* np = m_byKey.find(keyEntry(k));
+		if(np == nullptr)
+			return false;
+		m_byDeadline.erase(deadlineEntry(np->value().deadline, k));
+		m_byKey.erase(keyEntry(k));
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// returns k's deadline, even if it has passed
+	// throws invalid_argument if k is not present
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	typename expiryIndex<K, Clock>::time_point expiryIndex<K, Clock>::deadline(
+		const K& k) const
+	{
+		lock_guard<mutex> lock(m_lock);
+		const node<keyEntry>* np = m_byKey.find(keyEntry(k));
+		if(np == nullptr)
+			throw (invalid_argument("Key not present"));
+		return np->value().deadline;
+	}
+
+	//--------------------------------------------------------------------
+	// returns the earliest deadline, O(1)
+	// throws invalid_argument if the index is empty
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	typename expiryIndex<K, Clock>::time_point
+		expiryIndex<K, Clock>::nextDeadline() const
+	{
+		lock_guard<mutex> lock(m_lock);
+		return m_byDeadline.min().deadline;
+	}
+
+	//--------------------------------------------------------------------
+	// evicts the keys whose deadline is at or before now, the earliest
+	// first, at most limit of them, appending them to keys if given.
+	// Splits the expired prefix off the deadline tree, then extracts
+	// the same keys, sorted, from the key tree; the nodes of both land
+	// in trees that are freed once the lock is released.
+	// returns the number of keys evicted
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	size_t expiryIndex<K, Clock>::evictExpired(time_point now, size_t limit,
+		vector<K>* keys)
+	{
+		avl<deadlineEntry> expired;   // declared first, so freed unlocked
+		avl<keyEntry> gone;
+		lock_guard<mutex> lock(m_lock);
+		deadlineEntry cut(now, K(), true);
+		size_t due = m_byDeadline.rank(cut);
+		if(due > limit)
+		{
+			due = limit;
+			cut = m_byDeadline.select(limit);
+		}
+		if(due == 0)
+			return 0;
+
+		vector<keyEntry> doomed;
+		doomed.reserve(due);
+		for(typename avl<deadlineEntry>::iterator it = m_byDeadline.begin();
+			doomed.size() < due; ++it)
+			doomed.push_back(keyEntry((*it).key));
+		if(keys != nullptr)
+		{
+			keys->reserve(keys->size() + due);
+			for(size_t i = 0; i < doomed.size(); i++)
+				keys->push_back(doomed[i].key);
+		}
+		sort(doomed.begin(), doomed.end());
+
+		avl<deadlineEntry> live;
+		m_byDeadline.splitAt(cut, live);
+		expired.append(m_byDeadline);
+		m_byDeadline.append(live);
+		m_byKey.extract(doomed.data(), doomed.data() + due, gone);
+		m_evicted += due;
+		return due;
+	}
+
+	//--------------------------------------------------------------------
+	// starts a thread that wakes every interval and evicts whatever has
+	// expired, batch keys per lock hold; restarts it if already running
+	// throws invalid_argument for a zero batch, system_error
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	void expiryIndex<K, Clock>::startReaper(duration interval, size_t batch)
+	{
+		if(batch == 0)
+			throw (invalid_argument("Reaper batch must be positive"));
+		stopReaper();
+		lock_guard<mutex> lock(m_lock);
+		m_stopping = false;
+		m_reaper = thread(&expiryIndex<K, Clock>::reapLoop, this, interval,
+			batch);
+	}
+
+	//--------------------------------------------------------------------
+	// stops the reaper thread, if one is running, and waits for it
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	void expiryIndex<K, Clock>::stopReaper()
+	{
+		{
+			lock_guard<mutex> lock(m_lock);
+			if(!m_reaper.joinable())
+				return;
+			m_stopping = true;
+		}
+		m_wake.notify_one();
+		m_reaper.join();
+	}
+
+	//--------------------------------------------------------------------
+	// the reaper thread: sleeps for interval, then evicts in batches,
+	// letting other threads in between, until a batch comes up short
+	//--------------------------------------------------------------------
+	template <class K, class Clock>
+	void expiryIndex<K, Clock>::reapLoop(duration interval, size_t batch)
+	{
+		for(;;)
+		{
+			{
+				unique_lock<mutex> lock(m_lock);
+				if(m_wake.wait_for(lock, interval, [this] {return m_stopping;}))
+					return;
+			}
+			time_point now = Clock::now();
+			while(evictExpired(now, batch) == batch)
+				;
+		}
+	}
+
+} // end namespace AW_BST
+
+#endif
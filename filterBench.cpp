@@ -0,0 +1,154 @@
+//----------------------------------------------------------------------------
+// File:		filterBench.cpp
+//
+// Description: Benchmark of filteredAvl<T> against a plain avl<T> on a
+//				miss-heavy lookup stream, at configured false positive
+//				rates of 0.1 down to 1e-4, with the measured rate, probes
+//				and filter size of each
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				timeContains()
+//				measuredRate()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "filteredAvl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	timeContains()
+	// Title:		Times a run of lookups
+	// Description: Calls contains() for every query
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		set.contains()
+	// Called By:	main()
+	// Parameters:	const Set& set; avl<long> or filteredAvl<long>
+	//				const vector<long>& queries; keys to look up
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	template <class Set>
+	double timeContains(const Set& set, const vector<long>& queries)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long hits = 0;
+		for(size_t i = 0; i < queries.size(); i++)
+			hits += set.contains(queries[i]);
+		AW_BST::keepResult(hits);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	measuredRate()
+	// Title:		Measures a filter's false positive rate
+	// Description: Builds a bloomFilter the way filteredAvl<T> sizes its
+	//				own, adds keys, and counts how many of the given absent
+	//				keys it lets through
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		bloomFilter::add(), mayContain(), filterHash()
+	// Called By:	main()
+	// Parameters:	double rate; configured false positive rate
+	//				const vector<long>& keys; keys present
+	//				const vector<long>& absent; keys known to be absent
+	//				int& probes; set to the bits set per key
+	// Returns:		the fraction of absent keys let through
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double measuredRate(double rate, const vector<long>& keys,
+		const vector<long>& absent, int& probes)
+	{
+		AW_BST::bloomFilter filter(keys.size(), rate);
+		for(size_t i = 0; i < keys.size(); i++)
+			filter.add(AW_BST::filterHash(keys[i]));
+		size_t passed = 0;
+		for(size_t i = 0; i < absent.size(); i++)
+			passed += filter.mayContain(AW_BST::filterHash(absent[i]));
+		probes = filter.probes();
+		return static_cast<double>(passed) / absent.size();
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		filteredAvl benchmark
+// Description: Stores n random even keys and runs 4n lookups, seven in
+//				ten for odd keys that are never present, on an avl<long>
+//				and on filteredAvl<long> at each configured rate.  Both
+//				trees are bulk built from the same keys.
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: keys (default 1000000)
+// Output:		one row per configured rate
+// Calls:		timeContains(), measuredRate()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+	const double RATES[] = {0.1, 0.01, 0.001, 0.0001};
+	mt19937_64 rng(9);
+
+	vector<long> keys(n);
+	for(int i = 0; i < n; i++)
+		keys[i] = static_cast<long>(rng() >> 34) * 2;
+	vector<long> queries(4 * static_cast<size_t>(n));
+	for(size_t i = 0; i < queries.size(); i++)
+	{
+		if(i % 10 < 7)
+			queries[i] = static_cast<long>(rng() >> 34) * 2 + 1;
+		else
+			queries[i] = keys[rng() % n];
+	}
+	vector<long> absent(n);
+	for(int i = 0; i < n; i++)
+		absent[i] = static_cast<long>(rng() >> 34) * 2 + 1;
+
+	AW_BST::avl<long> plain;
+	plain.bulkInsert(keys.begin(), keys.end());
+	double plainTime = timeContains(plain, queries);
+
+	cout << n << " keys, " << queries.size() << " lookups, 70% misses" << endl;
+	cout << "  rate     k  bits/key  measured FPR     avl  filtered" << endl;
+	for(size_t r = 0; r < sizeof(RATES) / sizeof(RATES[0]); r++)
+	{
+		AW_BST::filteredAvl<long> filtered(RATES[r], n);
+		filtered.bulkInsert(keys.begin(), keys.end());
+		int probes = 0;
+		double fpr = measuredRate(RATES[r], keys, absent, probes);
+		cout << "  " << left << setw(7) << RATES[r] << right
+			<< setw(3) << probes << fixed << setprecision(1)
+			<< setw(10) << filtered.filterBytes() * 8.0 / n
+			<< setprecision(5) << setw(14) << fpr << setprecision(2)
+			<< setw(7) << plainTime << "s"
+			<< setw(9) << timeContains(filtered, queries) << "s" << endl;
+		cout.unsetf(ios::floatfield);
+	}
+	return EXIT_SUCCESS;
+}
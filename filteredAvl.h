@@ -0,0 +1,315 @@
+#ifndef FILTEREDAVL_H
+#define FILTEREDAVL_H
+//--------------------------------------------------------------------
+// An avl tree fronted by a Bloom filter that turns away misses
+//--------------------------------------------------------------------
+#include <functional>
+#include <cstdint>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Blocked Bloom Filter
+	// Class:		bloomFilter
+	//
+	// File:		filteredAvl.h
+	// Title:		bloomFilter Class
+	// Description: An approximate set of 64-bit hashes.  Each hash picks
+	//				one 512-bit block and sets k bits inside it, so a
+	//				lookup reads one block (one or two cache lines)
+	//				instead of k scattered words.  Each bit position is
+	//				the top of a fresh multiply of the hash, so the k bits
+	//				stay independent down to small rates.  It never reports
+	//				a false miss; a false hit happens at about the rate it
+	//				was sized for while it holds no more than its capacity.
+	//				Bits cannot be cleared, so removals need a rebuild.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class bloomFilter:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			void add(uint64_t h) -- adds a hash
+	//			bool mayContain(uint64_t h) const -- false if h was
+	//				certainly never added
+	//			void clear() -- empties the filter
+	//			size_t capacity() const -- keys it was sized for
+	//			size_t memoryUsage() const -- bytes of filter bits
+	//			int probes() const -- bits set per key
+	//
+	//     non-inline:
+	//			bloomFilter(size_t keys, double falsePositiveRate)
+	//				-- sizes the filter
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	class bloomFilter
+	{
+	public:
+		static const size_t BLOCK_WORDS = 8;     // 512 bits, one cache line
+
+		bloomFilter(size_t keys, double falsePositiveRate);
+
+		void add(uint64_t h)
+		{
+			uint64_t* block = &m_bits[blockOf(h) * BLOCK_WORDS];
+			uint64_t probe = h;
+			for(int i = 0; i < m_probes; i++)
+			{
+				probe *= 0x9e3779b97f4a7c15ull;
+				block[probe >> 61] |= uint64_t(1) << ((probe >> 55) & 63);
+			}
+		}
+		bool mayContain(uint64_t h) const
+		{
+			const uint64_t* block = &m_bits[blockOf(h) * BLOCK_WORDS];
+			uint64_t probe = h;
+			for(int i = 0; i < m_probes; i++)
+			{
+				probe *= 0x9e3779b97f4a7c15ull;
+				if(!(block[probe >> 61] & (uint64_t(1) << ((probe >> 55) & 63))))
+					return false;
+			}
+			return true;
+		}
+		void clear() {fill(m_bits.begin(), m_bits.end(), uint64_t(0));}
+		size_t capacity() const {return m_capacity;}
+		size_t memoryUsage() const {return m_bits.size() * sizeof(uint64_t);}
+		int probes() const {return m_probes;}
+
+	private:
+		size_t blockOf(uint64_t h) const   // high bits, scaled to m_blocks
+			{return static_cast<size_t>(((h >> 32) * m_blocks) >> 32);}
+
+		vector<uint64_t> m_bits;
+		uint64_t m_blocks;
+		size_t m_capacity;
+		int m_probes;
+	};
+
+	//--------------------------------------------------------------------
+	// sizes the filter for keys entries at falsePositiveRate.  An ideal
+	// filter needs -ln(p) / ln(2)^2 bits a key; blocks fill unevenly, so
+	// a fifth more is allowed.  At most 4G blocks (32G keys at 1%).
+	// throws invalid_argument for a rate outside (0, 1), bad_alloc
+	//--------------------------------------------------------------------
+	inline bloomFilter::bloomFilter(size_t keys, double falsePositiveRate)
+		: m_capacity(keys > 0 ? keys : 1)
+	{
+		if(!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0))
+			throw (invalid_argument("False positive rate must be in (0, 1)"));
+		const double ln2 = 0.69314718055994531;
+		double bitsPerKey = 1.2 * -log(falsePositiveRate) / (ln2 * ln2);
+		m_probes = static_cast<int>(bitsPerKey / 1.2 * ln2 + 0.5);
+		m_probes = (m_probes < 1) ? 1 : (m_probes > 16) ? 16 : m_probes;
+		double blocks = ceil(bitsPerKey * m_capacity / (BLOCK_WORDS * 64));
+		m_blocks = (blocks < 1.0) ? 1 : (blocks > 4294967295.0)
+			? 4294967295u : static_cast<uint64_t>(blocks);
+		m_bits.assign(static_cast<size_t>(m_blocks) * BLOCK_WORDS, 0);
+	}
+
+	//--------------------------------------------------------------------
+	// hashes d with std::hash, then mixes the bits (one splitmix64 step)
+	// since library hashes of integers are often the identity; the added
+	// constant keeps a zero hash from mixing to zero
+	//--------------------------------------------------------------------
+	template <class T>
+	inline uint64_t filterHash(const T& d)
+	{
+		uint64_t h = static_cast<uint64_t>(hash<T>()(d)) + 0x9e3779b97f4a7c15ull;
+		h ^= h >> 30;
+		h *= 0xbf58476d1ce4e5b9ull;
+		h ^= h >> 27;
+		h *= 0x94d049bb133111ebull;
+		return h ^ (h >> 31);
+	}
+
+	//--------------------------------------------------------------------
+	// Filtered AVL Tree
+	// Class:		filteredAvl<T>
+	//				REQUIRES Type T have < & == defined and a std::hash
+	//				specialization
+	//
+	// File:		filteredAvl.h
+	// Title:		filteredAvl template Class
+	// Description: An avl<T> with a blocked Bloom filter in front of it.
+	//				A lookup whose key the filter has never seen returns
+	//				after touching one block, without walking the tree;
+	//				everything else goes on to the tree, so answers are
+	//				always exact.  Inserts add to the filter.  Erased keys
+	//				stay in the filter until it is rebuilt from the tree,
+	//				which happens once erases reach half its capacity, and
+	//				it is rebuilt twice as large whenever the tree outgrows
+	//				that capacity.  The filter costs about
+	//				1.2 * 1.44 * log2(1 / rate) bits a key.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class filteredAvl<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			filteredAvl(double falsePositiveRate, size_t expectedKeys,
+	//				bool multiset) -- constructor
+	//			bool contains(const T& d) const -- true if d is present
+	//			size_t count(const T& d) const -- copies of d present
+	//			size_t size() const -- number of keys
+	//			bool isempty() const -- true if the tree is empty
+	//			const avl<T>& tree() const -- the tree itself
+	//			double falsePositiveRate() const -- the configured rate
+	//			size_t filterBytes() const -- memory used by the filter
+	//			void print(ostream& out) const -- prints the tree inorder
+	//
+	//     non-inline:
+	//			bool insert(const T& d) -- adds d
+	//			bool erase(const T& d) -- removes one copy of d
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a batch of keys
+	//			void rebuildFilter(size_t capacity)
+	//				-- refills the filter from the tree
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class filteredAvl
+	{
+	public:
+		explicit filteredAvl(double falsePositiveRate = 0.01,
+			size_t expectedKeys = 1024, bool multiset = false)
+			: m_tree(multiset), m_filter(expectedKeys, falsePositiveRate),
+			m_rate(falsePositiveRate), m_erased(0) {}
+
+		bool insert(const T& d);
+		bool erase(const T& d);
+		template <class InputIt>
+		int bulkInsert(InputIt first, InputIt last);
+		bool contains(const T& d) const
+			{return m_filter.mayContain(filterHash(d)) && m_tree.contains(d);}
+		size_t count(const T& d) const
+			{return m_filter.mayContain(filterHash(d)) ? m_tree.count(d) : 0;}
+		size_t size() const {return m_tree.size();}
+		bool isempty() const {return m_tree.isempty();}
+		const avl<T>& tree() const {return m_tree;}
+		double falsePositiveRate() const {return m_rate;}
+		size_t filterBytes() const {return m_filter.memoryUsage();}
+		void rebuildFilter(size_t capacity);
+		void print(ostream& out) const {m_tree.print(out);}
+
+	private:
+		avl<T> m_tree;
+		bloomFilter m_filter;
+		double m_rate;
+		size_t m_erased;     // keys erased since the filter was filled
+	};
+
+	//--------------------------------------------------------------------
+	// adds d to the tree and the filter, growing the filter first if the
+	// tree has outgrown it
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class T>
+	bool filteredAvl<T>::insert(const T& d)
+	{
+		if(!m_tree.insert(d))
+			return false;
+		if(m_tree.size() > m_filter.capacity())
+			rebuildFilter(2 * m_filter.capacity());
+		else
+			m_filter.add(filterHash(d));
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// removes one copy of d; a key the filter rules out is not looked for.
+	// Its bits stay set until the next rebuild.
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	bool filteredAvl<T>::erase(const T& d)
+	{
+		if(!m_filter.mayContain(filterHash(d)) || !m_tree.erase(d))
+			return false;
+		if(++m_erased > m_filter.capacity() / 2)
+			rebuildFilter(m_filter.capacity());
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// adds a batch of keys with avl<T>::bulkInsert(), then adds them to
+	// the filter, or rebuilds it if the tree has outgrown it
+	// returns the number of keys inserted
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class InputIt>
+	int filteredAvl<T>::bulkInsert(InputIt first, InputIt last)
+	{
+		vector<T> batch(first, last);
+		int inserted = m_tree.bulkInsert(batch.begin(), batch.end());
+		if(m_tree.size() > m_filter.capacity())
+		{
+			size_t capacity = m_filter.capacity();
+			while(capacity < m_tree.size())
+				capacity *= 2;
+			rebuildFilter(capacity);
+		}
+		else
+		{
+			for(size_t i = 0; i < batch.size(); i++)
+				m_filter.add(filterHash(batch[i]));
+		}
+		return inserted;
+	}
+
+	//--------------------------------------------------------------------
+	// replaces the filter with one sized for capacity keys (at least the
+	// tree's size) holding exactly the tree's keys, dropping the bits of
+	// erased keys
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void filteredAvl<T>::rebuildFilter(size_t capacity)
+	{
+		bloomFilter fresh((capacity > m_tree.size()) ? capacity
+			: m_tree.size(), m_rate);
+		for(typename avl<T>::iterator it = m_tree.begin(); it != m_tree.end();
+			++it)
+			fresh.add(filterHash<T>(*it));
+		m_filter = move(fresh);
+		m_erased = 0;
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for filteredAvl<T>
+	//--------------------------------------------------------------------
+	template <class T>
+	ostream& operator<<(ostream& out, const filteredAvl<T>& tree)
+	{
+		tree.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -0,0 +1,126 @@
+//----------------------------------------------------------------------------
+// File:		findManyBench.cpp
+//
+// Description: Benchmark of batched bst<T>::findMany() lookups against a
+//				loop of find() calls, on a tree that fits in cache and on
+//				one that does not
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				compare()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	const size_t SMALL_BATCH = 64;
+
+	//---------------------------------------------------------------------------
+	// Function:	compare()
+	// Title:		Times find() against findMany() on one tree
+	// Description: Inserts the even ints below 2 * keys into an avl<int>
+	//				in random order, then times uniform lookups in
+	//				[0, 2 * keys), half of them hits, as a find()
+	//				loop, as one findMany() call, and as findMany() calls
+	//				of SMALL_BATCH keys, checks that all three agree, and
+	//				prints one row
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::insert(), find(), findMany()
+	// Called By:	main()
+	// Parameters:	int keys; keys to insert
+	//				int lookups; lookups to time
+	// Returns:		true if the three runs found the same nodes
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	bool compare(int keys, int lookups)
+	{
+		mt19937 rng(2);
+		AW_BST::avl<int> tree;
+		vector<int> order(keys);
+		for(int i = 0; i < keys; i++)
+			order[i] = 2 * i;
+		shuffle(order.begin(), order.end(), rng);
+		for(int i = 0; i < keys; i++)
+			tree.insert(order[i]);
+		vector<int> queries(lookups);
+		for(int i = 0; i < lookups; i++)
+			queries[i] = static_cast<int>(rng() % (2u * keys));
+
+		vector<AW_BST::node<int>*> looped(lookups);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		for(int i = 0; i < lookups; i++)
+			looped[i] = tree.find(queries[i]);
+		double loopTime = AW_BST::secondsSince(start);
+
+		vector<AW_BST::node<int>*> batched;
+		start = chrono::steady_clock::now();
+		tree.findMany(queries, batched);
+		double batchTime = AW_BST::secondsSince(start);
+
+		vector<AW_BST::node<int>*> chunked(lookups);
+		start = chrono::steady_clock::now();
+		for(size_t i = 0; i < queries.size(); i += SMALL_BATCH)
+			tree.findMany(&queries[i], min(SMALL_BATCH, queries.size() - i),
+				&chunked[i]);
+		double chunkTime = AW_BST::secondsSince(start);
+
+		cout << setw(9) << tree.size() << setw(12) << loopTime << "s"
+			<< setw(13) << batchTime << "s" << setw(14) << chunkTime << "s"
+			<< endl;
+		return looped == batched && looped == chunked;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		findMany benchmark
+// Description: Runs compare() on a 10k-key tree and a 2M-key tree
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: lookups (default 4000000)
+// Output:		one row per tree size
+// Calls:		compare()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS, or EXIT_FAILURE if the results differed
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int lookups = (argc > 1) ? atoi(argv[1]) : 4000000;
+	const int SIZES[] = {10000, 2000000};
+	cout << lookups << " random lookups, half of them hits" << endl;
+	cout << "     keys   find loop     findMany   findMany/" << SMALL_BATCH
+		<< endl;
+	cout << fixed << setprecision(3);
+	bool same = true;
+	for(int s = 0; s < 2; s++)
+		same = compare(SIZES[s], lookups) && same;
+	if(!same)
+	{
+		cout << "findMany() and find() disagreed" << endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
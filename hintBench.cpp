@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------
+// File:		hintBench.cpp
+//
+// Description: Benchmark of hinted avl<T> inserts on sorted, nearly
+//				sorted and random key streams, against plain inserts
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				timeInserts()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	enum hintKind { NO_HINT, PREVIOUS_HINT, END_HINT };
+	const int REPEATS = 3;
+
+	//---------------------------------------------------------------------------
+	// Function:	timeInserts()
+	// Title:		Times inserting one stream
+	// Description: Inserts every key of stream into an empty avl<int>,
+	//				either plainly, with the iterator the previous insert
+	//				returned as the hint, or with end() as the hint, and
+	//				keeps the best of REPEATS runs
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::insert(), end()
+	// Called By:	main()
+	// Parameters:	const vector<int>& stream; keys, in insert order
+	//				hintKind kind; which hint to give
+	// Returns:		seconds taken by the fastest run
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double timeInserts(const vector<int>& stream, hintKind kind)
+	{
+		double best = 0;
+		for(int r = 0; r < REPEATS; r++)
+		{
+			AW_BST::avl<int> tree;
+			AW_BST::avl<int>::iterator hint = tree.end();
+			chrono::steady_clock::time_point start = chrono::steady_clock::now();
+			for(size_t i = 0; i < stream.size(); i++)
+			{
+				if(kind == NO_HINT)
+					tree.insert(stream[i]);
+				else if(kind == PREVIOUS_HINT)
+					tree.insert(hint, stream[i]);
+				else
+					tree.insert(tree.end(), stream[i]);
+			}
+			double seconds = AW_BST::secondsSince(start);
+			if(r == 0 || seconds < best)
+				best = seconds;
+		}
+		return best;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		Hinted insert benchmark
+// Description: Builds n ascending keys, the same keys with about one
+//				neighbour pair in ten swapped, and n random keys, and
+//				times each stream plainly, with the previous result as
+//				the hint, and with end() as the hint
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: n (default 2000000)
+// Output:		one row per stream
+// Calls:		timeInserts()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 2000000;
+	mt19937 rng(5);
+	vector<int> sorted(n);
+	vector<int> random(n);
+	for(int i = 0; i < n; i++)
+	{
+		sorted[i] = i;
+		random[i] = static_cast<int>(rng());
+	}
+	vector<int> nearly(sorted);
+	for(int i = 0; i + 1 < n; i++)
+		if(rng() % 10 == 0)
+			swap(nearly[i], nearly[i + 1]);
+
+	const char* NAMES[] = {"sorted", "nearly sorted", "random"};
+	const vector<int>* STREAMS[] = {&sorted, &nearly, &random};
+	cout << n << " inserts, best of " << REPEATS << endl;
+	cout << "  stream            plain  hint=previous  hint=end()" << endl;
+	cout << fixed << setprecision(3);
+	for(int s = 0; s < 3; s++)
+	{
+		cout << "  " << left << setw(14) << NAMES[s] << right
+			<< setw(8) << timeInserts(*STREAMS[s], NO_HINT) << "s"
+			<< setw(14) << timeInserts(*STREAMS[s], PREVIOUS_HINT) << "s"
+			<< setw(11) << timeInserts(*STREAMS[s], END_HINT) << "s" << endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,173 @@
+#ifndef INTERVALTREE_H
+#define INTERVALTREE_H
+//--------------------------------------------------------------------
+// An interval tree built on avl<T>
+//--------------------------------------------------------------------
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// INTERVAL
+	// a closed range [low, high], ordered by low then high.  maxHigh is
+	// the largest high anywhere in the subtree the interval heads; it is
+	// kept up to date by augment() and takes no part in ordering.
+	// REQUIRES Type K have < & == defined
+	//--------------------------------------------------------------------
+	template <class K>
+	struct interval
+	{
+		interval(K lo = K(), K hi = K()) : low(lo), high(hi), maxHigh(hi) {}
+		bool operator<(const interval<K>& i) const
+			{return low < i.low || (!(i.low < low) && high < i.high);}
+		bool operator==(const interval<K>& i) const
+			{return low == i.low && high == i.high;}
+		bool overlaps(const K& lo, const K& hi) const
+			{return !(hi < low) && !(high < lo);}
+
+		K low;
+		K high;
+		K maxHigh;
+	};
+
+	//--------------------------------------------------------------------
+	// recomputes maxHigh from the children; called by node<T>::update()
+	//--------------------------------------------------------------------
+	template <class K>
+	inline void augment(interval<K>& d, const node<interval<K>>* left,
+		const node<interval<K>>* right)
+	{
+		d.maxHigh = d.high;
+		if(left != nullptr && d.maxHigh < left->value().maxHigh)
+			d.maxHigh = left->value().maxHigh;
+		if(right != nullptr && d.maxHigh < right->value().maxHigh)
+			d.maxHigh = right->value().maxHigh;
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for interval<K>
+	//--------------------------------------------------------------------
+	template <class K>
+	ostream& operator<<(ostream& out, const interval<K>& i)
+	{
+		out << '[' << i.low << ',' << i.high << ']';
+		return out;
+	}
+
+	//--------------------------------------------------------------------
+	// Interval Tree
+	// Class:		intervalTree<K>: public avl<interval<K>>
+	//				REQUIRES Type K be default constructible & have
+	//				< & == defined
+	//
+	// File:		intervalTree.h
+	// Title:		intervalTree template Class; inherits from avl<T>
+	// Description: Stores closed intervals in an avl tree keyed on their
+	//				low ends, with every node also holding the largest high
+	//				end in its subtree.  An overlap query skips any subtree
+	//				whose largest high end falls before the query and stops
+	//				at the first interval starting after it, so it touches
+	//				only the paths leading to matches.  The tree counts
+	//				duplicates, so the same interval may be added twice.
+	//				Lazy erase is not available: a tombstone's high end
+	//				would stay in the maxima above it.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class intervalTree<K>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			intervalTree() -- default constructor
+	//			bool insert(const K& lo, const K& hi) -- adds [lo, hi]
+	//			bool erase(const K& lo, const K& hi) -- removes one [lo, hi]
+	//			void stab(const K& point, Visitor visit) const
+	//				-- visits every interval holding point
+	//			vector<interval<K>> findOverlapping(const K& lo,
+	//				const K& hi) const -- every interval overlapping [lo, hi]
+	//
+	//     non-inline:
+	//			void overlapping(const K& lo, const K& hi, Visitor visit)
+	//				const -- visits every interval overlapping [lo, hi]
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class K>
+	class intervalTree : public avl<interval<K>>
+	{
+	public:
+		intervalTree() : avl<interval<K>>(true) {}
+
+		bool insert(const K& lo, const K& hi)
+		{
+			if(hi < lo)
+				throw (invalid_argument("Interval ends before it starts"));
+			return avl<interval<K>>::insert(interval<K>(lo, hi));
+		}
+		bool erase(const K& lo, const K& hi)
+			{return avl<interval<K>>::erase(interval<K>(lo, hi));}
+
+		template <class Visitor>
+		void overlapping(const K& lo, const K& hi, Visitor visit) const;
+		template <class Visitor>
+		void stab(const K& point, Visitor visit) const
+			{overlapping(point, point, visit);}
+		vector<interval<K>> findOverlapping(const K& lo, const K& hi) const
+		{
+			vector<interval<K>> found;
+			overlapping(lo, hi, [&found](const interval<K>& i)
+				{found.push_back(i);});
+			return found;
+		}
+
+	protected:
+		using avl<interval<K>>::root;
+
+	private:   // tombstones would keep their high ends in the maxima
+		using avl<interval<K>>::setLazyErase;
+	};
+
+	//--------------------------------------------------------------------
+	// calls visit(interval) for every interval overlapping [lo, hi], in
+	// order of their low ends, once per copy
+	//--------------------------------------------------------------------
+	template <class K>
+	template <class Visitor>
+	void intervalTree<K>::overlapping(const K& lo, const K& hi,
+		Visitor visit) const
+	{
+		vector<const node<interval<K>>*> pending;
+		const node<interval<K>>* cur = root;
+		while(true)
+		{   // a subtree whose highest end is below lo holds no match
+			for(; cur != nullptr && !(cur->value().maxHigh < lo);
+				cur = cur->left)
+				pending.push_back(cur);
+			if(pending.empty())
+				return;
+			cur = pending.back();
+			pending.pop_back();
+			if(hi < cur->value().low)
+				return;    // it and everything after start too late
+			if(!(cur->value().high < lo))
+			{
+				for(size_t i = 0; i < cur->getCount(); i++)
+					visit(cur->value());
+			}
+			cur = cur->right;
+		}
+	}
+
+} // end namespace AW_BST
+
+#endif
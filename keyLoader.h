@@ -0,0 +1,282 @@
+#ifndef KEYLOADER_H
+#define KEYLOADER_H
+//--------------------------------------------------------------------
+// Streaming key loader for avl trees
+//--------------------------------------------------------------------
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <limits>
+#include <chrono>
+#include <type_traits>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Key Loader
+	// Functions:	loadKeys(istream& in, avl<T>& tree, ...)
+	//				loadKeys(const string& fileName, avl<T>& tree, ...)
+	//				REQUIRES parseKey() be defined for T
+	//
+	// File:		keyLoader.h
+	// Title:		Buffered bulk loading of delimited keys into an avl
+	// Description: Reads delimiter-separated keys from a stream in large
+	//				chunks straight from the stream buffer, parses each
+	//				key in place (no per-key string is built for numeric
+	//				or char keys), moves them into a reusable batch and
+	//				hands each full batch to avl<T>::bulkInsert(), which
+	//				sorts it in place and moves the keys into the nodes:
+	//				a string key is allocated once, by its parse
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// struct loadStats:
+	//			size_t keysRead -- keys parsed from the input
+	//			size_t keysInserted -- keys that were new to the tree
+	//			size_t keysRejected -- non-empty fields that failed to parse
+	//			size_t bytesRead -- bytes consumed from the input
+	//			double seconds -- wall time spent loading
+	//			double keysPerSecond() const -- keysRead / seconds
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+
+	struct loadStats
+	{
+		loadStats() : keysRead(0), keysInserted(0), keysRejected(0),
+			bytesRead(0), seconds(0.0) {}
+		double keysPerSecond() const
+			{return (seconds > 0.0) ? keysRead / seconds : 0.0;}
+
+		size_t keysRead;
+		size_t keysInserted;
+		size_t keysRejected;
+		size_t bytesRead;
+		double seconds;
+	};
+
+	const size_t LOAD_CHUNK_SIZE = 1 << 20;
+	const size_t LOAD_BATCH_SIZE = 1 << 16;
+
+	//--------------------------------------------------------------------
+	// parses a whole field as a signed integer
+	// returns false on an empty field, stray characters or overflow
+	//--------------------------------------------------------------------
+	template <class T>
+	typename enable_if<is_integral<T>::value && is_signed<T>::value,
+		bool>::type
+	parseInteger(const char* first, const char* last, T& key)
+	{
+		bool negative = false;
+		if(first != last && (*first == '-' || *first == '+'))
+			negative = (*first++ == '-');
+		if(first == last)
+			return false;
+		unsigned long long limit =
+			static_cast<unsigned long long>(numeric_limits<T>::max());
+		if(negative)
+			limit++;
+		unsigned long long total = 0;
+		for(; first != last; ++first)
+		{
+			unsigned digit = static_cast<unsigned>(*first - '0');
+			if(digit > 9 || total > (limit - digit) / 10)
+				return false;
+			total = total * 10 + digit;
+		}
+		key = negative ? static_cast<T>(0 - total) : static_cast<T>(total);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// parses a whole field as an unsigned integer
+	//--------------------------------------------------------------------
+	template <class T>
+	typename enable_if<is_integral<T>::value && !is_signed<T>::value,
+		bool>::type
+	parseInteger(const char* first, const char* last, T& key)
+	{
+		if(first != last && *first == '+')
+			++first;
+		if(first == last)
+			return false;
+		unsigned long long limit = numeric_limits<T>::max();
+		unsigned long long total = 0;
+		for(; first != last; ++first)
+		{
+			unsigned digit = static_cast<unsigned>(*first - '0');
+			if(digit > 9 || total > (limit - digit) / 10)
+				return false;
+			total = total * 10 + digit;
+		}
+		key = static_cast<T>(total);
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// parseKey overloads -- convert one field [first, last) to a key
+	// add an overload here to load a new key type
+	//--------------------------------------------------------------------
+	inline bool parseKey(const char* first, const char* last, char& key)
+	{  // a char key is a field of exactly one character
+		if(last - first != 1)
+			return false;
+		key = *first;
+		return true;
+	}
+
+	inline bool parseKey(const char* first, const char* last, string& key)
+	{
+		key.assign(first, last);
+		return true;
+	}
+
+	inline bool parseKey(const char* first, const char* last, double& key)
+	{
+		const size_t MAX_DIGITS = 64;
+		char digits[MAX_DIGITS];
+		size_t length = static_cast<size_t>(last - first);
+		if(length == 0 || length >= MAX_DIGITS)
+			return false;
+		memcpy(digits, first, length);
+		digits[length] = '\0';
+		char* end = nullptr;
+		key = strtod(digits, &end);
+		return (end == digits + length);
+	}
+
+	inline bool parseKey(const char* first, const char* last, float& key)
+	{
+		double temp = 0.0;
+		if(!parseKey(first, last, temp))
+			return false;
+		key = static_cast<float>(temp);
+		return true;
+	}
+
+	template <class T>
+	typename enable_if<is_integral<T>::value && !is_same<T, char>::value,
+		bool>::type
+	parseKey(const char* first, const char* last, T& key)
+	{
+		return parseInteger(first, last, key);
+	}
+
+	//--------------------------------------------------------------------
+	// reads delimiter-separated keys from in and bulk inserts them
+	// empty fields are skipped; a '\r' before a '\n' delimiter is dropped
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	loadStats loadKeys(istream& in, avl<T>& tree, char delim = '\n',
+		size_t batchSize = LOAD_BATCH_SIZE)
+	{
+		loadStats stats;
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		streambuf* source = in.rdbuf();
+		vector<char> buffer(LOAD_CHUNK_SIZE);
+		vector<T> batch;
+		batch.reserve(batchSize);
+		T key = T();
+		size_t carry = 0;    // bytes of an unfinished field at the front
+		bool done = (source == nullptr);
+
+		while(!done)
+		{
+			if(carry == buffer.size())
+				buffer.resize(buffer.size() * 2); // field longer than a chunk
+			streamsize got = source->sgetn(&buffer[carry],
+				static_cast<streamsize>(buffer.size() - carry));
+			if(got <= 0)
+			{
+				done = true;
+				if(carry == 0)
+					break;
+			}
+			stats.bytesRead += static_cast<size_t>((got > 0) ? got : 0);
+			const char* cur = buffer.data();
+			const char* end = buffer.data() + carry + (got > 0 ? got : 0);
+
+			while(cur != end)
+			{
+				const char* stop = static_cast<const char*>(
+					memchr(cur, delim, static_cast<size_t>(end - cur)));
+				if(stop == nullptr)
+				{
+					if(!done)
+						break;     // wait for the rest of the field
+					stop = end;    // last field has no trailing delimiter
+				}
+				const char* fieldEnd = stop;
+				if(delim == '\n' && fieldEnd != cur && fieldEnd[-1] == '\r')
+					--fieldEnd;
+				if(fieldEnd != cur)
+				{
+					if(parseKey(cur, fieldEnd, key))
+					{
+						batch.push_back(std::move(key));
+						stats.keysRead++;
+						if(batch.size() >= batchSize)
+							stats.keysInserted += tree.bulkInsert(
+								std::move(batch));   // sorted in place, emptied
+					}
+					else
+						stats.keysRejected++;
+				}
+				cur = (stop == end) ? end : stop + 1;
+			}
+			carry = static_cast<size_t>(end - cur);
+			if(carry != 0 && cur != buffer.data())
+				memmove(buffer.data(), cur, carry);
+		}
+		if(!batch.empty())
+			stats.keysInserted += tree.bulkInsert(std::move(batch));
+		stats.seconds = chrono::duration<double>(
+			chrono::steady_clock::now() - start).count();
+		return stats;
+	}
+
+	//--------------------------------------------------------------------
+	// loads keys from the named file
+	// throws invalid_argument if the file cannot be opened, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	loadStats loadKeys(const string& fileName, avl<T>& tree,
+		char delim = '\n', size_t batchSize = LOAD_BATCH_SIZE)
+	{
+		ifstream in(fileName.c_str(), ios::in | ios::binary);
+		if(!in)
+			throw (invalid_argument("Could not open key file " + fileName));
+		return loadKeys(in, tree, delim, batchSize);
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for loadStats
+	//--------------------------------------------------------------------
+	inline ostream& operator<<(ostream& out, const loadStats& stats)
+	{
+		ios::fmtflags flags = out.flags();
+		streamsize precision = out.precision();
+		out << stats.keysRead << " keys read, " << stats.keysInserted
+			<< " inserted, " << stats.keysRejected << " rejected, "
+			<< stats.bytesRead << " bytes in " << fixed << setprecision(3)
+			<< stats.seconds << " s (" << setprecision(0)
+			<< stats.keysPerSecond() << " keys/s)";
+		out.flags(flags);
+		out.precision(precision);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -0,0 +1,140 @@
+//----------------------------------------------------------------------------
+// File:		lookupBench.cpp
+//
+// Description: Benchmark of find() on avl<int> and avl<string>, the two
+//				key kinds node<T> stores and returns differently, with the
+//				node size of each
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				timeLookups()
+//				stringKey()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	timeLookups()
+	// Title:		Times random lookups
+	// Description: Calls find() for every query
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<T>::find()
+	// Called By:	main()
+	// Parameters:	const avl<T>& tree; tree to search
+	//				const vector<T>& queries; keys to find
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	template <class T>
+	double timeLookups(const AW_BST::avl<T>& tree, const vector<T>& queries)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long hits = 0;
+		for(size_t i = 0; i < queries.size(); i++)
+			hits += (tree.find(queries[i]) != nullptr);
+		AW_BST::keepResult(hits);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	stringKey()
+	// Title:		Builds a string key
+	// Description: Formats k as a path-like key with a shared prefix, long
+	//				enough that it does not fit a short-string buffer
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		n/a
+	// Called By:	main()
+	// Parameters:	unsigned k; key number
+	// Returns:		the key
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	string stringKey(unsigned k)
+	{
+		ostringstream key;
+		key << "/accounts/region-" << k % 16 << "/user-" << setw(9)
+			<< setfill('0') << k;
+		return key.str();
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		int and string lookup benchmark
+// Description: Times 4M lookups on a 1M-key avl<int> and 1M lookups on
+//				a 250k-key avl<string>.  The trees hold the even keys,
+//				inserted in random order, and the lookups are uniform,
+//				so half of them hit.
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: int keys (default 1000000); the string
+//				tree gets a quarter as many
+// Output:		node size and seconds for each tree
+// Calls:		timeLookups(), stringKey()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int stringKeys = n / 4;
+	mt19937 rng(11);
+
+	vector<unsigned> order(n);
+	for(int i = 0; i < n; i++)
+		order[i] = 2u * i;
+	shuffle(order.begin(), order.end(), rng);
+
+	AW_BST::avl<int> ints;
+	for(int i = 0; i < n; i++)
+		ints.insert(static_cast<int>(order[i]));
+	vector<int> intQueries(4 * n);
+	for(size_t i = 0; i < intQueries.size(); i++)
+		intQueries[i] = static_cast<int>(rng() % (2u * n));
+
+	AW_BST::avl<string> strings;
+	for(int i = 0; i < n; i++)
+		if(order[i] < 2u * stringKeys)
+			strings.insert(stringKey(order[i]));
+	vector<string> stringQueries(4 * stringKeys);
+	for(size_t i = 0; i < stringQueries.size(); i++)
+		stringQueries[i] = stringKey(rng() % (2u * stringKeys));
+
+	cout << fixed << setprecision(2);
+	cout << "avl<int>     " << ints.size() << " keys, node "
+		<< sizeof(AW_BST::node<int>) << " bytes, " << intQueries.size()
+		<< " lookups  " << timeLookups(ints, intQueries) << "s" << endl;
+	cout << "avl<string>  " << strings.size() << " keys, node "
+		<< sizeof(AW_BST::node<string>) << " bytes, " << stringQueries.size()
+		<< " lookups  " << timeLookups(strings, stringQueries) << "s" << endl;
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+#ifndef MERKLETREE_H
+#define MERKLETREE_H
+//--------------------------------------------------------------------
+// An avl set whose subtrees carry hashes, so replicas diff cheaply
+//--------------------------------------------------------------------
+#include "filteredAvl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// MERKLE ENTRY
+	// a key, its hash, and the sum (mod 2^64) of the hashes of the
+	// subtree the entry heads (kept by augment()).  A sum does not depend
+	// on the shape of the tree, so two trees holding the same keys agree
+	// on every key range however differently they were built.
+	// REQUIRES Type K have < & == defined and a std::hash specialization
+	//--------------------------------------------------------------------
+	template <class K>
+	struct merkleEntry
+	{
+		merkleEntry(K k = K()) : key(k), hash(filterHash(key)), subtree(hash)
+			{}
+		bool operator<(const merkleEntry<K>& e) const {return key < e.key;}
+		bool operator==(const merkleEntry<K>& e) const {return key == e.key;}
+
+		K key;
+		uint64_t hash;
+		uint64_t subtree;
+	};
+
+	//--------------------------------------------------------------------
+	// recomputes subtree from the children; called by node<T>::update()
+	//--------------------------------------------------------------------
+	template <class K>
+	inline void augment(merkleEntry<K>& d, const node<merkleEntry<K>>* left,
+		const node<merkleEntry<K>>* right)
+	{
+		d.subtree = d.hash + (left ? left->value().subtree : 0)
+			+ (right ? right->value().subtree : 0);
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for merkleEntry<K>
+	//--------------------------------------------------------------------
+	template <class K>
+	ostream& operator<<(ostream& out, const merkleEntry<K>& e)
+	{
+		out << e.key;
+		return out;
+	}
+
+	//--------------------------------------------------------------------
+	// Merkle Tree
+	// Class:		merkleTree<K> : public avl<merkleEntry<K>>
+	//				REQUIRES Type K be default constructible, have
+	//				< & == defined and a std::hash specialization
+	//
+	// File:		merkleTree.h
+	// Title:		merkleTree template Class; inherits from avl<T>
+	// Description: A set of unique keys in which every node holds the
+	//				hash of its whole subtree.  The hashes are refreshed by
+	//				node<T>::update(), so they follow every insert, erase
+	//				and rotation at no extra asymptotic cost, and
+	//				rangeHash(lo, hi) sums a key range from O(log n)
+	//				subtree hashes.  Lazy erase is not available: a
+	//				tombstone's hash would stay in the hashes above it.
+	//
+	//				diff() walks this tree and skips every subtree whose
+	//				hash matches the same key range of the other tree, so
+	//				it finds d differing keys with O(d log n) range
+	//				queries of O(log n) each, not a walk of both trees.
+	//				A replica in another process answers the same
+	//				rangeHash() queries to sync without shipping its keys.
+	//				Hashes come from std::hash, so replicas must run the
+	//				same build.  Two different key sets collide with
+	//				probability about 2^-64 per range compared.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class merkleTree<K>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			merkleTree() -- default constructor
+	//			bool insert(const K& k) -- adds k; false if present
+	//			bool erase(const K& k) -- removes k
+	//			bool contains(const K& k) const -- true if k is present
+	//			uint64_t rootHash() const -- hash of the whole set
+	//			uint64_t rangeHash(const K& lo, const K& hi) const
+	//				-- hash of the keys in [lo, hi]
+	//
+	//     non-inline:
+	//			void diff(const merkleTree<K>& other, vector<K>& onlyHere,
+	//				vector<K>& onlyThere) const
+	//				-- the keys held by just one of the two trees
+	//		private:
+	//			uint64_t hashBelow(const K* bound, bool inclusive) const
+	//				-- hash of the keys below (or up to) bound
+	//			uint64_t hashBetween(const K* lo, const K* hi) const
+	//				-- hash of the keys strictly between lo and hi
+	//			void diff(const node<entry>* np, const K* lo,
+	//				const K* hi, ...) const -- diffs one subtree
+	//			void collect(const node<entry>* np, const K* lo,
+	//				const K* hi, vector<K>& keys) const
+	//				-- appends the keys strictly between lo and hi
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class K>
+	class merkleTree : public avl<merkleEntry<K>>
+	{
+	public:
+		typedef merkleEntry<K> entry;
+
+		merkleTree() : avl<entry>() {}
+
+		bool insert(const K& k) {return avl<entry>::insert(entry(k));}
+		bool erase(const K& k) {return avl<entry>::erase(entry(k));}
+		bool contains(const K& k) const
+			{return avl<entry>::contains(entry(k));}
+		uint64_t rootHash() const {return root ? root->value().subtree : 0;}
+		uint64_t rangeHash(const K& lo, const K& hi) const
+			{return (hi < lo) ? 0 : hashBelow(&hi, true) - hashBelow(&lo, false);}
+		void diff(const merkleTree<K>& other, vector<K>& onlyHere,
+			vector<K>& onlyThere) const;
+
+	protected:
+		using avl<entry>::root;
+
+	private:
+		using avl<entry>::setLazyErase;   // tombstones would stay hashed
+		uint64_t hashBelow(const K* bound, bool inclusive) const;
+		uint64_t hashBetween(const K* lo, const K* hi) const
+		{
+			return (hi ? hashBelow(hi, false) : rootHash())
+				- (lo ? hashBelow(lo, true) : 0);
+		}
+		void diff(const node<entry>* np, const K* lo, const K* hi,
+			const merkleTree<K>& other, vector<K>& onlyHere,
+			vector<K>& onlyThere) const;
+		void collect(const node<entry>* np, const K* lo, const K* hi,
+			vector<K>& keys) const;
+	};
+
+	//--------------------------------------------------------------------
+	// sums the hashes of the keys below bound (up to and including it
+	// when inclusive), taking whole left subtrees on the way down;
+	// a null bound means no keys
+	//--------------------------------------------------------------------
+	template <class K>
+	uint64_t merkleTree<K>::hashBelow(const K* bound, bool inclusive) const
+	{
+		uint64_t sum = 0;
+		const node<entry>* np = (bound != nullptr) ? root : nullptr;
+		while(np != nullptr)
+		{
+			const K& key = np->value().key;
+			if(key < *bound || (inclusive && key == *bound))
+			{
+				sum += np->value().hash;
+				if(np->left != nullptr)
+					sum += np->left->value().subtree;
+				np = np->right;
+			}
+			else
+				np = np->left;
+		}
+		return sum;
+	}
+
+	//--------------------------------------------------------------------
+	// fills onlyHere with the keys this tree holds and other does not,
+	// and onlyThere with the reverse, each in ascending order.  Each
+	// node here splits the key space; a subtree whose hash matches the
+	// other tree's hash of the same open key range is taken as equal.
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class K>
+	void merkleTree<K>::diff(const merkleTree<K>& other, vector<K>& onlyHere,
+		vector<K>& onlyThere) const
+	{
+		onlyHere.clear();
+		onlyThere.clear();
+		diff(root, nullptr, nullptr, other, onlyHere, onlyThere);
+	}
+
+	//--------------------------------------------------------------------
+	// diffs the subtree at np, whose keys lie strictly between lo and hi
+	// (null for unbounded), against other's keys in that range;
+	// recursive, as deep as this tree is high
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class K>
+	void merkleTree<K>::diff(const node<entry>* np, const K* lo, const K* hi,
+		const merkleTree<K>& other, vector<K>& onlyHere,
+		vector<K>& onlyThere) const
+	{
+		uint64_t there = other.hashBetween(lo, hi);
+		if(np == nullptr)
+		{
+			if(there != 0)
+				other.collect(other.root, lo, hi, onlyThere);
+			return;
+		}
+		if(np->value().subtree == there)
+			return;
+		const K& key = np->value().key;
+		diff(np->left, lo, &key, other, onlyHere, onlyThere);
+		if(!other.contains(key))
+			onlyHere.push_back(key);
+		diff(np->right, &key, hi, other, onlyHere, onlyThere);
+	}
+
+	//--------------------------------------------------------------------
+	// appends, in order, the keys of the subtree at np strictly between
+	// lo and hi (null for unbounded); visits only subtrees that reach
+	// into the range
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class K>
+	void merkleTree<K>::collect(const node<entry>* np, const K* lo,
+		const K* hi, vector<K>& keys) const
+	{
+		while(np != nullptr)
+		{
+			const K& key = np->value().key;
+			if(lo != nullptr && !(*lo < key))
+				np = np->right;
+			else if(hi != nullptr && !(key < *hi))
+				np = np->left;
+			else
+			{
+				collect(np->left, lo, nullptr, keys);
+				keys.push_back(key);
+				np = np->right;
+				lo = nullptr;    // everything right of key is above lo
+			}
+		}
+	}
+
+} // end namespace AW_BST
+
+#endif
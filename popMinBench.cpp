@@ -0,0 +1,223 @@
+//----------------------------------------------------------------------------
+// File:		popMinBench.cpp
+//
+// Description: Benchmark of avl<T>::popMin() used as a priority queue,
+//				against std::multiset and std::priority_queue, and of
+//				draining a tree with popMin() against erase(min())
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				queueAvl()
+//				queueMultiset()
+//				queuePriority()
+//				drainAvl()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <functional>
+#include <queue>
+#include <random>
+#include <set>
+#include <vector>
+#include "avl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	queueAvl()
+	// Title:		Times avl<int> as a priority queue
+	// Description: Pushes every key into a multiset avl<int>, popping the
+	//				smallest after every second push, then pops the rest
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::insert(), popMin(), isempty()
+	// Called By:	main()
+	// Parameters:	const vector<int>& keys; the keys to push, in order
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double queueAvl(const vector<int>& keys)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		AW_BST::avl<int> tree(true);
+		long long sum = 0;
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			tree.insert(keys[i]);
+			if(i % 2 == 1)
+				sum += tree.popMin();
+		}
+		while(!tree.isempty())
+			sum += tree.popMin();
+		AW_BST::keepResult(sum);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	queueMultiset()
+	// Title:		Times std::multiset as a priority queue
+	// Description: The queueAvl() workload on std::multiset<int>, popping
+	//				with erase(begin())
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		multiset<int>::insert(), erase(), begin()
+	// Called By:	main()
+	// Parameters:	const vector<int>& keys; the keys to push, in order
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double queueMultiset(const vector<int>& keys)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		multiset<int> tree;
+		long long sum = 0;
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			tree.insert(keys[i]);
+			if(i % 2 == 1)
+			{
+				sum += *tree.begin();
+				tree.erase(tree.begin());
+			}
+		}
+		while(!tree.empty())
+		{
+			sum += *tree.begin();
+			tree.erase(tree.begin());
+		}
+		AW_BST::keepResult(sum);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	queuePriority()
+	// Title:		Times std::priority_queue
+	// Description: The queueAvl() workload on a min-heap priority_queue
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		priority_queue<int>::push(), top(), pop()
+	// Called By:	main()
+	// Parameters:	const vector<int>& keys; the keys to push, in order
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double queuePriority(const vector<int>& keys)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		priority_queue<int, vector<int>, greater<int>> heap;
+		long long sum = 0;
+		for(size_t i = 0; i < keys.size(); i++)
+		{
+			heap.push(keys[i]);
+			if(i % 2 == 1)
+			{
+				sum += heap.top();
+				heap.pop();
+			}
+		}
+		while(!heap.empty())
+		{
+			sum += heap.top();
+			heap.pop();
+		}
+		AW_BST::keepResult(sum);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	drainAvl()
+	// Title:		Times emptying an avl<int> from the low end
+	// Description: Inserts every key, then removes the smallest until the
+	//				tree is empty, either with popMin() or with
+	//				erase(min()).  Only the removals are timed.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::insert(), popMin(), erase(), min(), isempty()
+	// Called By:	main()
+	// Parameters:	const vector<int>& keys; the keys to insert
+	//				bool usePop; popMin() if true, else erase(min())
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	double drainAvl(const vector<int>& keys, bool usePop)
+	{
+		AW_BST::avl<int> tree(true);
+		for(size_t i = 0; i < keys.size(); i++)
+			tree.insert(keys[i]);
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long long sum = 0;
+		while(!tree.isempty())
+		{
+			if(usePop)
+				sum += tree.popMin();
+			else
+			{
+				int low = tree.min();
+				tree.erase(low);
+				sum += low;
+			}
+		}
+		AW_BST::keepResult(sum);
+		return AW_BST::secondsSince(start);
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		popMin benchmark
+// Description: Times n random pushes with a pop after every second push,
+//				then a drain, on avl<int>, std::multiset and
+//				std::priority_queue; then times draining n keys from an
+//				avl<int> with popMin() and with erase(min())
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional argument: number of keys (default 1000000)
+// Output:		seconds for each container and each drain
+// Calls:		queueAvl(), queueMultiset(), queuePriority(), drainAvl()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+	mt19937 rng(5);
+	vector<int> keys(n);
+	for(int i = 0; i < n; i++)
+		keys[i] = static_cast<int>(rng() % (4u * n));
+
+	cout << fixed << setprecision(2);
+	cout << n << " pushes, a pop after every second push, then drain" << endl;
+	cout << "  avl<int> popMin        " << queueAvl(keys) << "s" << endl;
+	cout << "  std::multiset          " << queueMultiset(keys) << "s" << endl;
+	cout << "  std::priority_queue    " << queuePriority(keys) << "s" << endl;
+	cout << "draining " << n << " keys from an avl<int>" << endl;
+	cout << "  popMin()               " << drainAvl(keys, true) << "s" << endl;
+	cout << "  erase(min())           " << drainAvl(keys, false) << "s" << endl;
+	return EXIT_SUCCESS;
+}
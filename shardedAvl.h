@@ -0,0 +1,391 @@
+#ifndef SHARDEDAVL_H
+#define SHARDEDAVL_H
+//--------------------------------------------------------------------
+// An ordered set split by key range over avl trees with their own locks
+//--------------------------------------------------------------------
+#include <mutex>
+#include <shared_mutex>
+#include <memory>
+#include <algorithm>
+#include "avl.h"
+#include "concurrentSet.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Sharded AVL Tree
+	// Class:		shardedAvl<T>
+	//				REQUIRES Type T be able convert from int & have
+	//				< & == defined
+	//
+	// File:		shardedAvl.h
+	// Title:		shardedAvl template Class
+	// Description: Partitions the key space into K ranges at K - 1
+	//				sorted bounds and keeps each range in its own avl<T>
+	//				behind its own mutex, so point operations on different
+	//				shards run in parallel.  Shard i holds the keys from
+	//				bounds[i - 1] up to, but not including, bounds[i].
+	//
+	//				A point operation routes through the current bounds,
+	//				locks that one shard, and retries if the bounds were
+	//				replaced meanwhile; old bounds are freed through an
+	//				epochReclaimer, so routing takes no shared lock.
+	//				rebalance() moves the bounds to the K-quantiles of the
+	//				keys by appending every shard into one tree and
+	//				splitting it again, O(K log n) with all shards locked.
+	//				An insert that leaves its shard more than the
+	//				rebalance ratio times the average size triggers one.
+	//
+	//				scan() and forEach() visit the shards in key order,
+	//				locking one at a time, so they see each shard
+	//				consistently but not the whole set at one instant.  A
+	//				visitor must not call back into the container.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class shardedAvl<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			~shardedAvl() -- destructor
+	//			bool insert(const T& d) -- adds d
+	//			bool erase(const T& d) -- removes one copy of d
+	//			bool contains(const T& d) const -- true if d is present
+	//			size_t count(const T& d) const -- copies of d present
+	//			size_t shards() const -- number of shards, K
+	//			void setRebalanceRatio(double ratio) -- 0 turns off
+	//				automatic rebalancing
+	//
+	//     non-inline:
+	//			shardedAvl(const vector<T>& bounds, bool multiset)
+	//				-- constructor; K = bounds.size() + 1
+	//			size_t size() const -- number of keys
+	//			size_t shardSize(size_t i) const -- keys in shard i
+	//			vector<T> bounds() const -- the current bounds
+	//			void scan(const T& lo, const T& hi, Visitor visit) const
+	//				-- visits the keys in [lo, hi] in order
+	//			void forEach(Visitor visit) const -- visits every key
+	//			void rebalance() -- evens out the shards
+	//			void print(ostream& out) const -- prints the keys inorder
+	//		private:
+	//			shard& lockShard(const T& d,
+	//				unique_lock<mutex>& held) const
+	//				-- locks the shard that owns d
+	//			void noteGrowth(size_t shardSize)
+	//				-- rebalances if a shard has outgrown the rest
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class shardedAvl
+	{
+		struct shard;
+		struct layout;
+	public:
+		static const size_t REBALANCE_MIN = 4096;  // smaller shards never trigger
+
+		explicit shardedAvl(const vector<T>& bounds, bool multiset = false);
+		~shardedAvl() {delete m_layout.load();}
+
+		bool insert(const T& d)
+		{
+			unique_lock<mutex> held;
+			shard& s = lockShard(d, held);
+			bool inserted = s.tree.insert(d);
+			size_t grown = s.tree.size();
+			held.unlock();
+			if(inserted)
+				noteGrowth(grown);
+			return inserted;
+		}
+		bool erase(const T& d)
+		{
+			unique_lock<mutex> held;
+			return lockShard(d, held).tree.erase(d);
+		}
+		bool contains(const T& d) const
+		{
+			unique_lock<mutex> held;
+			return lockShard(d, held).tree.contains(d);
+		}
+		size_t count(const T& d) const
+		{
+			unique_lock<mutex> held;
+			return lockShard(d, held).tree.count(d);
+		}
+		size_t size() const;
+		size_t shards() const {return m_shards.size();}
+		size_t shardSize(size_t i) const;
+		vector<T> bounds() const;
+		template <class Visitor>
+		void scan(const T& lo, const T& hi, Visitor visit) const;
+		template <class Visitor>
+		void forEach(Visitor visit) const;
+		void rebalance();
+		void setRebalanceRatio(double ratio) {m_ratio.store(ratio);}
+		void print(ostream& out) const;
+
+	private:
+		struct shard
+		{
+			explicit shard(bool multiset) : tree(multiset) {}
+			mutex lock;
+			avl<T> tree;
+		};
+		struct layout
+		{
+			explicit layout(const vector<T>& b) : bounds(b) {}
+			size_t route(const T& d) const
+			{
+				return static_cast<size_t>(upper_bound(bounds.begin(),
+					bounds.end(), d) - bounds.begin());
+			}
+			vector<T> bounds;
+		};
+
+		shardedAvl(const shardedAvl<T>&);             // not copyable
+		shardedAvl<T>& operator=(const shardedAvl<T>&);
+
+		shard& lockShard(const T& d, unique_lock<mutex>& held) const;
+		void noteGrowth(size_t shardSize);
+		static void freeLayout(void* p) {delete static_cast<layout*>(p);}
+
+		vector<unique_ptr<shard>> m_shards;
+		atomic<const layout*> m_layout;
+		mutable epochReclaimer m_reclaimer;   // frees replaced layouts
+		mutable shared_timed_mutex m_scanning; // scans share, rebalance owns
+		mutex m_rebalancing;
+		atomic<size_t> m_average;   // keys per shard at the last rebalance
+		atomic<double> m_ratio;
+	};
+
+	template <class T>
+	const size_t shardedAvl<T>::REBALANCE_MIN;
+
+	//--------------------------------------------------------------------
+	// creates bounds.size() + 1 empty shards split at bounds
+	// throws invalid_argument if bounds is out of order, bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	shardedAvl<T>::shardedAvl(const vector<T>& bounds, bool multiset)
+		: m_layout(nullptr), m_average(0), m_ratio(2.0)
+	{
+		for(size_t i = 1; i < bounds.size(); i++)
+		{
+			if(bounds[i] < bounds[i - 1])
+				throw (invalid_argument("Shard bounds must be sorted"));
+		}
+		for(size_t i = 0; i <= bounds.size(); i++)
+			m_shards.push_back(unique_ptr<shard>(new shard(multiset)));
+		m_layout.store(new layout(bounds));
+	}
+
+	//--------------------------------------------------------------------
+	// finds the shard that owns d and returns it locked in held.  The
+	// bounds are read inside an epoch guard so they cannot be freed
+	// under us; once the shard is locked, unchanged bounds mean no
+	// rebalance can move d elsewhere until the lock is released.
+	//--------------------------------------------------------------------
+	template <class T>
+	typename shardedAvl<T>::shard& shardedAvl<T>::lockShard(const T& d,
+		unique_lock<mutex>& held) const
+	{
+		epochReclaimer::guard pin(m_reclaimer);
+		for(;;)
+		{
+			const layout* current = m_layout.load(memory_order_acquire);
+			shard& s = *m_shards[current->route(d)];
+			unique_lock<mutex> lock(s.lock);
+			if(m_layout.load(memory_order_acquire) == current)
+			{
+				held = move(lock);
+				return s;
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// rebalances once a shard holds more than the ratio times the
+	// average a rebalance left behind; skipped while another thread is
+	// already rebalancing
+	//--------------------------------------------------------------------
+	template <class T>
+	void shardedAvl<T>::noteGrowth(size_t shardSize)
+	{
+		double ratio = m_ratio.load(memory_order_relaxed);
+		if(ratio <= 0.0 || shardSize < REBALANCE_MIN || static_cast<double>(
+			shardSize) <= ratio * m_average.load(memory_order_relaxed))
+			return;
+		unique_lock<mutex> one(m_rebalancing, try_to_lock);
+		if(one.owns_lock())
+		{
+			one.unlock();
+			rebalance();
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// returns the number of keys, summed shard by shard
+	//--------------------------------------------------------------------
+	template <class T>
+	size_t shardedAvl<T>::size() const
+	{
+		size_t total = 0;
+		for(size_t i = 0; i < m_shards.size(); i++)
+		{
+			lock_guard<mutex> lock(m_shards[i]->lock);
+			total += m_shards[i]->tree.size();
+		}
+		return total;
+	}
+
+	//--------------------------------------------------------------------
+	// returns the number of keys in shard i
+	// throws out_of_range for a shard that does not exist
+	//--------------------------------------------------------------------
+	template <class T>
+	size_t shardedAvl<T>::shardSize(size_t i) const
+	{
+		if(i >= m_shards.size())
+			throw (out_of_range("No such shard"));
+		lock_guard<mutex> lock(m_shards[i]->lock);
+		return m_shards[i]->tree.size();
+	}
+
+	//--------------------------------------------------------------------
+	// returns a copy of the current bounds
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	vector<T> shardedAvl<T>::bounds() const
+	{
+		shared_lock<shared_timed_mutex> steady(m_scanning);
+		return m_layout.load()->bounds;
+	}
+
+	//--------------------------------------------------------------------
+	// calls visit(key) for every key in [lo, hi] in ascending order,
+	// once per copy, walking only the shards whose ranges meet [lo, hi].
+	// The bounds hold still for the whole scan.
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class Visitor>
+	void shardedAvl<T>::scan(const T& lo, const T& hi, Visitor visit) const
+	{
+		if(hi < lo)
+			return;
+		shared_lock<shared_timed_mutex> steady(m_scanning);
+		const layout* current = m_layout.load();
+		size_t first = current->route(lo);
+		size_t last = current->route(hi);
+		for(size_t i = first; i <= last; i++)
+		{
+			lock_guard<mutex> lock(m_shards[i]->lock);
+			const avl<T>& tree = m_shards[i]->tree;
+			for(typename avl<T>::iterator it = tree.lowerBound(lo);
+				it != tree.end() && !(hi < *it); ++it)
+			{
+				for(size_t c = it.getNode()->getCount(); c > 0; c--)
+					visit(*it);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// calls visit(key) for every key in ascending order, once per copy
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class Visitor>
+	void shardedAvl<T>::forEach(Visitor visit) const
+	{
+		shared_lock<shared_timed_mutex> steady(m_scanning);
+		for(size_t i = 0; i < m_shards.size(); i++)
+		{
+			lock_guard<mutex> lock(m_shards[i]->lock);
+			const avl<T>& tree = m_shards[i]->tree;
+			for(typename avl<T>::iterator it = tree.begin(); it != tree.end();
+				++it)
+			{
+				for(size_t c = it.getNode()->getCount(); c > 0; c--)
+					visit(*it);
+			}
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// moves the bounds to the K-quantiles of the keys so every shard
+	// holds about the same number.  With every shard locked, appends
+	// the shards into one tree, picks the new bounds with select(), and
+	// splits the tree back apart from the top; each step relinks nodes
+	// in O(log n), so writers pause for O(K log n).
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void shardedAvl<T>::rebalance()
+	{
+		lock_guard<mutex> one(m_rebalancing);
+		unique_lock<shared_timed_mutex> steady(m_scanning);
+		vector<unique_lock<mutex>> locks;
+		locks.reserve(m_shards.size());
+		for(size_t i = 0; i < m_shards.size(); i++)
+			locks.push_back(unique_lock<mutex>(m_shards[i]->lock));
+
+		size_t k = m_shards.size();
+		size_t total = 0;
+		for(size_t i = 0; i < k; i++)
+			total += m_shards[i]->tree.size();
+		if(total == 0)
+			return;
+		avl<T>& all = m_shards[0]->tree;
+		for(size_t i = 1; i < k; i++)
+			all.append(m_shards[i]->tree);
+		vector<T> bounds;
+		bounds.reserve(k - 1);
+		for(size_t i = 1; i < k; i++)
+			bounds.push_back(all.select(total / k * i + total % k * i / k));
+		unique_ptr<layout> fresh(new layout(bounds));
+		for(size_t i = k - 1; i > 0; i--)
+		{
+			avl<T> upper;
+			all.splitAt(bounds[i - 1], upper);
+			m_shards[i]->tree.append(upper);
+		}
+		const layout* old = m_layout.exchange(fresh.release(),
+			memory_order_acq_rel);
+		m_average.store(total / k, memory_order_relaxed);
+		m_reclaimer.retire(const_cast<layout*>(old), freeLayout);
+	}
+
+	//--------------------------------------------------------------------
+	// prints out every key inorder, separated by spaces
+	//--------------------------------------------------------------------
+	template <class T>
+	void shardedAvl<T>::print(ostream& out) const
+	{
+		streamWriter w(out);
+		forEach([&w](const T& d) {writeValue(w, d); w.put(' ');});
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for shardedAvl<T>
+	//--------------------------------------------------------------------
+	template <class T>
+	ostream& operator<<(ostream& out, const shardedAvl<T>& tree)
+	{
+		tree.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
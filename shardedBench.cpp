@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------
+// File:		shardedBench.cpp
+//
+// Description: Benchmark of shardedAvl<T> on a mixed workload, for shard
+//				counts K of 1 to 64 at 1 to 64 threads
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				runSharded()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <thread>
+#include "shardedAvl.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	runSharded()
+	// Title:		Times the mixed workload on K shards
+	// Description: Builds a shardedAvl<int> with K shards split evenly
+	//				over [0, range) and runs runMix() on it.  Automatic
+	//				rebalancing is off, so only the routing and the shard
+	//				locks are measured.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		runMix()
+	// Called By:	main()
+	// Parameters:	int shards; K
+	//				int threads; worker threads
+	//				long ops; operations per thread
+	//				int range; keys are drawn from [0, range)
+	// Returns:		operations per second, all threads together
+	// History Log: 10-19-26 AW Completed v 1.0
+	//				10-19-26 AW the workload itself comes from benchMix.h
+	//---------------------------------------------------------------------------
+	double runSharded(int shards, int threads, long ops, int range)
+	{
+		vector<int> bounds;
+		for(int i = 1; i < shards; i++)
+			bounds.push_back(static_cast<int>(
+				static_cast<long long>(range) * i / shards));
+		AW_BST::shardedAvl<int> set(bounds);
+		set.setRebalanceRatio(0);
+		return AW_BST::runMix(set, threads, ops, range);
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		shardedAvl scaling benchmark
+// Description: Prints millions of operations per second for every
+//				pairing of K = 1, 2, 4 ... 64 shards with 1, 2, 4 ... 64
+//				threads.  K = 1 is a single avl<int> behind one mutex;
+//				scaling needs as many cores as threads.
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional arguments: operations per thread (default
+//				200000) and key range (default 1000000)
+// Output:		one line per thread count, one column per K
+// Calls:		runSharded()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	long ops = (argc > 1) ? atol(argv[1]) : 200000;
+	int range = (argc > 2) ? atoi(argv[2]) : 1000000;
+	const int MAX_SHARDS = 64;
+	const int MAX_THREADS = 64;
+	cout << "mix: 80% contains, 10% insert, 10% erase; " << range
+		<< " keys; " << thread::hardware_concurrency() << " cores" << endl;
+	cout << "Mops/s by threads (rows) and shards K (columns)" << endl;
+	cout << "threads";
+	for(int shards = 1; shards <= MAX_SHARDS; shards *= 2)
+		cout << setw(8) << ("K=" + to_string(shards));
+	cout << endl;
+	for(int threads = 1; threads <= MAX_THREADS; threads *= 2)
+	{
+		cout << setw(7) << threads << fixed << setprecision(2);
+		for(int shards = 1; shards <= MAX_SHARDS; shards *= 2)
+			cout << setw(8) << runSharded(shards, threads, ops, range) / 1e6;
+		cout << endl;
+	}
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,451 @@
+#ifndef SHAREDAVL_H
+#define SHAREDAVL_H
+//--------------------------------------------------------------------
+// A copy-on-write avl tree whose copies share structure
+//--------------------------------------------------------------------
+#include <atomic>
+#include <algorithm>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// Shared AVL Tree
+	// Class:		sharedAvl<T>: protected avl<T>
+	//				REQUIRES Type T meet avl<T>'s requirements
+	//
+	// File:		sharedAvl.h
+	// Title:		sharedAvl template Class; built on avl<T>
+	// Description: An avl tree whose nodes are reference counted, so a
+	//				copy just shares the root and costs O(1).  A change
+	//				clones only the nodes on its root-to-leaf path (and
+	//				the few a rotation changes) that some other copy still
+	//				refers to; nodes this tree owns alone are changed in
+	//				place.  tree + x is therefore O(log n) in time and
+	//				memory.  Separate copies may be used from different
+	//				threads; a single copy is not thread safe.
+	//
+	//				Lookups, iterators, rank & select, min & max, counts
+	//				and printing are avl<T>'s own, and so is the
+	//				rebalancing: insert and erase own the nodes a
+	//				rotation will change, then call avl<T>::rebalance().
+	//				Members that relink nodes in place or hand them out
+	//				for writing (getroot, the set operations, hinted
+	//				insert, compact, lazy erase) stay hidden, since
+	//				another copy may share those nodes; find() returns a
+	//				const node.  avl<T>'s own copy constructor, operator=
+	//				and operator+ are unchanged and still copy the whole
+	//				tree in O(n).
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.1
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class sharedAvl<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			sharedAvl(bool multiset = false) -- default constructor; a
+	//				multiset counts duplicates instead of dropping them
+	//			sharedAvl(const sharedAvl<T>& t) -- copy constructor, O(1)
+	//			~sharedAvl() -- releases this copy's hold on the nodes
+	//			const node<T>* find(const T& d) const -- d's node, or
+	//				nullptr
+	//			bool insert(T d) -- adds d; false if a set holds it
+	//			bool erase(const T& d) -- removes one copy of d; false
+	//				if absent
+	//			T popMin() -- removes & returns the smallest element
+	//			T popMax() -- removes & returns the largest element
+	//			sharedAvl<T>& operator+=(const T& d) -- adds an element
+	//			sharedAvl<T> operator+(const T& d) const
+	//				-- a copy with d added, O(log n)
+	//			void delTree() -- empties this copy
+	//			from avl<T>: isempty, isMultiset, size, getHeight,
+	//				getNumberOfNodes, contains, count, rank, select,
+	//				begin, end, last, lowerBound, min, max, print,
+	//				printPrefix, printXlevel, printJSON, printDOT,
+	//				levelOrder, rotations
+	//
+	//     non-inline:
+	//			sharedAvl<T>& operator=(const sharedAvl<T>& t) -- O(1)
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a batch; builds the tree if it is empty
+	//			void forEach(Visitor visit) const -- visits every copy
+	//				of every key in order
+	//		protected:
+	//			static void own(node<T>*& np)
+	//				-- clones np first if another copy shares it
+	//			static void release(node<T>* np)
+	//				-- drops a reference, freeing nodes nobody holds
+	//			static node<T>* buildBalanced(T* first, T* last,
+	//				const size_t* counts) -- a balanced subtree of
+	//				sorted keys
+	//			void insert(T d, node<T>*& np)
+	//			void erase(const T& d, node<T>*& np, bool wholeNode)
+	//			void rebalance(node<T>*& np)
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//					10-19-26 AW built on avl<T>: its rotations,
+	//						lookups and printing replace this class's own;
+	//						added multiset mode, find, iterators & pops
+	//-------------------------------------------------------------------
+	template <class T>
+	class sharedAvl : protected avl<T>
+	{
+	public:
+		typedef bstIterator<T> iterator;
+		typedef typename node<T>::valueType valueType;
+
+		explicit sharedAvl(bool multiset = false) : avl<T>(multiset) {}
+		sharedAvl(const sharedAvl<T>& t) : avl<T>(t.m_multiset)
+		{
+			root = t.root;
+			if(root != nullptr)
+				shared(root)->refs.fetch_add(1);
+			findEnds();
+		}
+		sharedAvl<T>& operator=(const sharedAvl<T>& t);
+		~sharedAvl() {release(root); root = nullptr;}
+
+		using avl<T>::isempty;
+		using avl<T>::isMultiset;
+		using avl<T>::size;
+		using avl<T>::getHeight;
+		using avl<T>::getNumberOfNodes;
+		using avl<T>::contains;
+		using avl<T>::count;
+		using avl<T>::rank;
+		using avl<T>::select;
+		using avl<T>::begin;
+		using avl<T>::end;
+		using avl<T>::last;
+		using avl<T>::lowerBound;
+		using avl<T>::min;
+		using avl<T>::max;
+		using avl<T>::print;
+		using avl<T>::printPrefix;
+		using avl<T>::printXlevel;
+		using avl<T>::printJSON;
+		using avl<T>::printDOT;
+		using avl<T>::levelOrder;
+		using avl<T>::rotations;
+
+		const node<T>* find(const T& d) const {return avl<T>::find(d);}
+		bool insert(T d)
+		{
+			if(!m_multiset && contains(d))
+				return false;
+			reserveRoom(1);
+			insert(std::move(d), root);
+			findEnds();
+			return true;
+		}
+		bool erase(const T& d)
+		{
+			if(!contains(d))
+				return false;
+			erase(d, root, false);
+			findEnds();
+			return true;
+		}
+		T popMin() {T d = min(); erase(d); return d;}
+		T popMax() {T d = max(); erase(d); return d;}
+		sharedAvl<T>& operator+=(const T& d) {insert(d); return *this;}
+		sharedAvl<T> operator+(const T& d) const
+			{sharedAvl<T> temp = *this; temp.insert(d); return temp;}
+		void delTree() {release(root); root = nullptr; findEnds();}
+		template <class InputIt>
+		int bulkInsert(InputIt first, InputIt last);
+		template <class Visitor>
+		void forEach(Visitor visit) const;
+
+	protected:
+		using avl<T>::root;
+		using avl<T>::m_multiset;
+		using avl<T>::reserveRoom;
+		using avl<T>::findEnds;
+		using avl<T>::getHeightDifference;
+
+		struct sharedNode : public node<T>
+		{
+			explicit sharedNode(T d) : node<T>(std::move(d)), refs(1) {}
+			static void* operator new(size_t bytes)   // never compacted
+				{return ::operator new(bytes);}
+			static void operator delete(void* p) {::operator delete(p);}
+			atomic<size_t> refs;     // trees and parents pointing here
+		};
+		static sharedNode* shared(node<T>* np)   // every node is one
+			{return static_cast<sharedNode*>(np);}
+
+		static void own(node<T>*& np);
+		static void release(node<T>* np);
+		static node<T>* buildBalanced(T* first, T* last,
+			const size_t* counts);
+		void insert(T d, node<T>*& np);
+		void erase(const T& d, node<T>*& np, bool wholeNode);
+		void rebalance(node<T>*& np);
+	};
+
+	//--------------------------------------------------------------------
+	// overloaded =; shares t's nodes
+	//--------------------------------------------------------------------
+	template <class T>
+	sharedAvl<T>& sharedAvl<T>::operator=(const sharedAvl<T>& t)
+	{
+		if(t.root != nullptr)
+			shared(t.root)->refs.fetch_add(1);
+		release(root);
+		root = t.root;
+		m_multiset = t.m_multiset;
+		findEnds();
+		return *this;
+	}
+
+	//--------------------------------------------------------------------
+	// sorts the batch and counts (or, for a set, drops) duplicates, then
+	// builds the tree directly if it is empty, otherwise inserts the keys
+	// one by one
+	// returns the number of keys actually inserted
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class InputIt>
+	int sharedAvl<T>::bulkInsert(InputIt first, InputIt last)
+	{
+		vector<T> batch(first, last);
+		sort(batch.begin(), batch.end());
+		if(!isempty())
+		{
+			int count = 0;
+			for(size_t i = 0; i < batch.size(); i++)
+			{
+				if(insert(batch[i]))
+					count++;
+			}
+			return count;
+		}
+		vector<size_t> counts;
+		size_t kept = 0;
+		for(size_t i = 0; i < batch.size(); i++)
+		{
+			if(kept != 0 && batch[i] == batch[kept - 1])
+			{
+				if(m_multiset)
+					counts.back()++;
+				continue;
+			}
+			if(kept != i)
+				batch[kept] = std::move(batch[i]);
+			kept++;
+			counts.push_back(1);
+		}
+		size_t total = m_multiset ? batch.size() : kept;
+		reserveRoom(total);
+		root = buildBalanced(batch.data(), batch.data() + kept, counts.data());
+		findEnds();
+		return static_cast<int>(total);
+	}
+
+	//--------------------------------------------------------------------
+	// calls visit(d) for every copy of every key in order
+	// a copy taken first can be walked while the original changes
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class Visitor>
+	void sharedAvl<T>::forEach(Visitor visit) const
+	{
+		for(iterator it = begin(); it != end(); ++it)
+		{
+			for(size_t c = it.getNode()->getCount(); c > 0; c--)
+				visit(*it);
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// builds a balanced subtree from sorted unique keys, the middle key
+	// at the root of each subtree; counts[i] copies of first[i].
+	// recursion depth is O(log n)
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	node<T>* sharedAvl<T>::buildBalanced(T* first, T* last,
+		const size_t* counts)
+	{
+		if(first == last)
+			return nullptr;
+		T* middle = first + (last - first) / 2;
+		node<T>* mid = new sharedNode(std::move(*middle));
+		mid->setCount(counts[middle - first]);
+		try
+		{
+			mid->left = buildBalanced(first, middle, counts);
+			mid->right = buildBalanced(middle + 1, last,
+				counts + (middle + 1 - first));
+		}
+		catch(bad_alloc&)
+		{
+			release(mid);
+			throw;
+		}
+		mid->update();
+		return mid;
+	}
+
+	//--------------------------------------------------------------------
+	// leaves np alone if this tree holds the only reference to it;
+	// otherwise replaces it with a private clone sharing np's children,
+	// giving up the reference to np itself
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void sharedAvl<T>::own(node<T>*& np)
+	{
+		if(shared(np)->refs.load(memory_order_acquire) == 1)
+			return;
+		node<T>* copy = new sharedNode(np->value());
+		copy->setCount(np->getCount());
+		copy->left = np->left;
+		copy->right = np->right;
+		if(copy->left != nullptr)
+			shared(copy->left)->refs.fetch_add(1);
+		if(copy->right != nullptr)
+			shared(copy->right)->refs.fetch_add(1);
+		copy->update();
+		release(np);
+		np = copy;
+	}
+
+	//--------------------------------------------------------------------
+	// drops one reference to np, freeing it and then its children's
+	// references when it was the last; iterative
+	//--------------------------------------------------------------------
+	template <class T>
+	void sharedAvl<T>::release(node<T>* np)
+	{
+		vector<node<T>*> pending;
+		if(np != nullptr)
+			pending.push_back(np);
+		while(!pending.empty())
+		{
+			sharedNode* cur = shared(pending.back());
+			pending.pop_back();
+			if(cur->refs.fetch_sub(1, memory_order_acq_rel) != 1)
+				continue;
+			if(cur->left != nullptr)
+				pending.push_back(cur->left);
+			if(cur->right != nullptr)
+				pending.push_back(cur->right);
+			delete cur;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// inserts d below np, owning each node on the way down; a copy of a
+	// key already present (multiset only) adds to its node's count
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void sharedAvl<T>::insert(T d, node<T>*& np)
+	{
+		if(np == nullptr)
+		{
+			np = new sharedNode(std::move(d));
+			return;
+		}
+		own(np);
+		if(d == np->value())
+			np->setCount(np->getCount() + 1);
+		else
+		{
+			node<T>*& next = (d < np->value()) ? np->left : np->right;
+			insert(std::move(d), next);
+		}
+		np->update();
+		rebalance(np);
+	}
+
+	//--------------------------------------------------------------------
+	// erases one copy of d (every copy, if wholeNode) below np, owning
+	// each node on the way down; a node with two children takes its
+	// in-order successor's key and count
+	// pre: d is in the subtree
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void sharedAvl<T>::erase(const T& d, node<T>*& np, bool wholeNode)
+	{
+		own(np);
+		if(!(d == np->value()))
+			erase(d, (d < np->value()) ? np->left : np->right, wholeNode);
+		else if(!wholeNode && np->getCount() > 1)
+			np->setCount(np->getCount() - 1);
+		else if(np->left == nullptr || np->right == nullptr)
+		{
+			sharedNode* doomed = shared(np);
+			np = (np->left != nullptr) ? np->left : np->right;
+			doomed->left = doomed->right = nullptr;  // np took them over
+			delete doomed;
+			return;
+		}
+		else
+		{
+			const node<T>* successor = np->right;
+			while(successor->left != nullptr)
+				successor = successor->left;
+			np->setdata(successor->value());
+			np->setCount(successor->getCount());
+			erase(np->value(), np->right, true);
+		}
+		np->update();
+		rebalance(np);
+	}
+
+	//--------------------------------------------------------------------
+	// owns the nodes a rotation at np would change, the heavy child and,
+	// for a double rotation, its inner child, then lets avl<T> restore
+	// the balance
+	// pre: np is owned by this tree
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void sharedAvl<T>::rebalance(node<T>*& np)
+	{
+		int balance = getHeightDifference(np);
+		if(balance > avlBalance::slack)
+		{
+			own(np->left);
+			if(getHeightDifference(np->left) < 0)
+				own(np->left->right);
+		}
+		else if(balance < -avlBalance::slack)
+		{
+			own(np->right);
+			if(getHeightDifference(np->right) > 0)
+				own(np->right->left);
+		}
+		else
+			return;
+		avl<T>::rebalance(np);
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for sharedAvl<T>
+	//--------------------------------------------------------------------
+	template <class T>
+	ostream& operator<<(ostream& out, const sharedAvl<T>& tree)
+	{
+		tree.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
@@ -0,0 +1,455 @@
+#ifndef SMALLAVL_H
+#define SMALLAVL_H
+//--------------------------------------------------------------------
+// A small-size-optimized ordered set
+//--------------------------------------------------------------------
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// SMALL AVL ITERATOR
+	// walks a smallAvl<T, N> inorder: a pointer into the inline array
+	// while the keys are inline, an avl<T> iterator once promoted.  Any
+	// change to the set invalidates it.
+	//--------------------------------------------------------------------
+	template <class T>
+	class smallAvlIterator
+	{
+	public:
+		explicit smallAvlIterator(const T* key) : m_key(key) {}
+		explicit smallAvlIterator(const bstIterator<T>& it)
+			: m_key(nullptr), m_tree(it) {}
+		typename node<T>::valueType operator*() const
+			{return m_key ? *m_key : *m_tree;}
+		smallAvlIterator<T>& operator++()
+			{if(m_key) ++m_key; else ++m_tree; return *this;}
+		smallAvlIterator<T>& operator--()
+			{if(m_key) --m_key; else --m_tree; return *this;}
+		bool operator==(const smallAvlIterator<T>& it) const
+			{return m_key == it.m_key && m_tree == it.m_tree;}
+		bool operator!=(const smallAvlIterator<T>& it) const
+			{return !(*this == it);}
+	private:
+		const T* m_key;           // nullptr once the set is a tree
+		bstIterator<T> m_tree;
+	};
+
+	//--------------------------------------------------------------------
+	// Small AVL Set
+	// Class:		smallAvl<T, N>
+	//				REQUIRES Type T be default constructible, be able to
+	//				convert from int & have < & == defined
+	//
+	// File:		smallAvl.h
+	// Title:		smallAvl template Class
+	// Description: Holds up to N keys inline in a sorted array, with no
+	//				heap allocation at all, and moves them into an avl<T>
+	//				once an insert would exceed N.  When erases bring a
+	//				promoted set back down to N / 2 keys it returns to the
+	//				array.  Lookups in the array use a branch-free counting
+	//				scan for arithmetic keys (which the compiler can
+	//				vectorize) and a binary search otherwise.
+	//
+	//				The interface is a deliberate subset of avl<T>'s:
+	//				membership, ordered iteration, min, max and the pops
+	//				work the same in both modes.  Members that hand out
+	//				nodes or describe the tree's shape (find, findMany,
+	//				getroot, getHeight, printXlevel, printJSON,
+	//				printDOT) have no inline counterpart and are left
+	//				out, as are multisets and the set operations other
+	//				than +=.  print() writes "value " for every key in
+	//				both modes.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class smallAvl<T, N>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			smallAvl() -- default constructor
+	//			~smallAvl() -- destructor
+	//			bool isempty() const -- true if the set holds no keys
+	//			bool isInline() const -- true while keys live in the array
+	//			int getNumberOfNodes() const -- number of keys, O(1)
+	//			size_t size() const -- number of keys, O(1)
+	//			size_t count(const T& d) const -- 1 if d is in the set,
+	//				else 0
+	//			bool contains(const T& d) const -- true if d is in the set
+	//			iterator begin() const -- the smallest key
+	//			iterator end() const -- one past the largest key
+	//			smallAvl& operator+=(const T d) -- adds an element
+	//			smallAvl operator+(const T d) -- adds an element
+	//			void delTree() -- removes every key
+	//
+	//     non-inline:
+	//			smallAvl(const smallAvl& s) -- copy constructor (deep copy)
+	//			smallAvl& operator=(const smallAvl& s) -- deep copy
+	//			smallAvl& operator+=(const smallAvl& s) -- adds a set
+	//			bool insert(T d) -- adds an element
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a batch of elements
+	//			bool erase(const T& d) -- removes an element
+	//			valueType min() const -- the smallest key
+	//			valueType max() const -- the largest key
+	//			T popMin() -- removes & returns the smallest key
+	//			T popMax() -- removes & returns the largest key
+	//			void print(ostream& out) const -- prints the keys inorder
+	//		protected:
+	//			size_t lowerBound(const T& d) const
+	//				-- index of the first inline key not less than d
+	//			T popEnd(bool high) -- removes the smallest or largest
+	//				key
+	//			void promote() -- moves the inline keys into a tree
+	//			void demote() -- moves the tree's keys back inline
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//					10-19-26 AW added size, count, iterators, min, max
+	//						& the pops; one print format in both modes
+	//-------------------------------------------------------------------
+	template <class T, size_t N = 32>
+	class smallAvl
+	{
+	public:
+		typedef smallAvlIterator<T> iterator;
+		typedef typename node<T>::valueType valueType;
+
+		smallAvl() : m_size(0), m_tree(nullptr) {}
+		smallAvl(const smallAvl<T, N>& s);
+		smallAvl<T, N>& operator=(const smallAvl<T, N>& s);
+		~smallAvl() {delete m_tree;}
+
+		bool isempty() const {return m_size == 0;}
+		bool isInline() const {return m_tree == nullptr;}
+		int getNumberOfNodes() const {return static_cast<int>(m_size);}
+		size_t size() const {return m_size;}
+		size_t count(const T& d) const {return contains(d) ? 1 : 0;}
+		bool contains(const T& d) const;
+		iterator begin() const
+			{return m_tree ? iterator(m_tree->begin()) : iterator(m_keys);}
+		iterator end() const
+			{return m_tree ? iterator(m_tree->end())
+				: iterator(m_keys + m_size);}
+		bool insert(T d);
+		template <class InputIt>
+		int bulkInsert(InputIt first, InputIt last);
+		bool erase(const T& d);
+		valueType min() const;
+		valueType max() const;
+		T popMin() {return popEnd(false);}
+		T popMax() {return popEnd(true);}
+		void delTree() {delete m_tree; m_tree = nullptr; m_size = 0;}
+		void print(ostream& out) const;
+
+		smallAvl<T, N>& operator+=(const smallAvl<T, N>& s);
+		smallAvl<T, N>& operator+=(const T d) {insert(d); return *this;}
+		smallAvl<T, N> operator+(const T d)
+			{smallAvl<T, N> temp = *this; temp.insert(d); return temp;}
+
+	protected:
+		size_t lowerBound(const T& d) const;
+		T popEnd(bool high);
+		void promote();
+		void demote();
+
+		T m_keys[N];      // sorted, first m_size entries used while inline
+		size_t m_size;    // number of keys, inline or in m_tree
+		avl<T>* m_tree;   // nullptr while the keys are inline
+	};
+
+	//--------------------------------------------------------------------
+	// COPY CONSTRUCTOR
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	smallAvl<T, N>::smallAvl(const smallAvl<T, N>& s)
+		: m_size(s.m_size), m_tree(nullptr)
+	{
+		if(s.m_tree != nullptr)
+			m_tree = new avl<T>(*s.m_tree);
+		else
+			copy(s.m_keys, s.m_keys + s.m_size, m_keys);
+	}
+
+	//--------------------------------------------------------------------
+	// overloaded =
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	smallAvl<T, N>& smallAvl<T, N>::operator=(const smallAvl<T, N>& s)
+	{
+		if(this != &s)
+		{
+			avl<T>* tree = (s.m_tree != nullptr)
+				? new avl<T>(*s.m_tree) : nullptr;
+			delete m_tree;
+			m_tree = tree;
+			m_size = s.m_size;
+			if(m_tree == nullptr)
+				copy(s.m_keys, s.m_keys + s.m_size, m_keys);
+		}
+		return *this;
+	}
+
+	//--------------------------------------------------------------------
+	// overloaded +=
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	smallAvl<T, N>& smallAvl<T, N>::operator+=(const smallAvl<T, N>& s)
+	{
+		if(s.m_tree == nullptr)
+			bulkInsert(s.m_keys, s.m_keys + s.m_size);
+		else
+		{
+			vector<T> keys;
+			keys.reserve(s.m_size);
+			s.m_tree->levelOrder([&keys](const node<T>* np, int)
+				{keys.push_back(np->value());});
+			bulkInsert(keys.begin(), keys.end());
+		}
+		return *this;
+	}
+
+	//--------------------------------------------------------------------
+	// returns the index of the first inline key that is not less than d
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	size_t smallAvl<T, N>::lowerBound(const T& d) const
+	{
+		if(is_arithmetic<T>::value)
+		{  // count the smaller keys; no data-dependent branches
+			size_t position = 0;
+			for(size_t i = 0; i < m_size; i++)
+				position += (m_keys[i] < d) ? 1 : 0;
+			return position;
+		}
+		return static_cast<size_t>(
+			lower_bound(m_keys, m_keys + m_size, d) - m_keys);
+	}
+
+	//--------------------------------------------------------------------
+	// returns true if d is in the set
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	inline bool smallAvl<T, N>::contains(const T& d) const
+	{
+		if(m_tree != nullptr)
+			return m_tree->contains(d);
+		size_t position = lowerBound(d);
+		return position < m_size && m_keys[position] == d;
+	}
+
+	//--------------------------------------------------------------------
+	// inserts a new element, promoting to a tree when the array is full
+	// returns true if d was inserted; false if it was already present
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	bool smallAvl<T, N>::insert(T d)
+	{
+		if(m_tree == nullptr)
+		{
+			size_t position = lowerBound(d);
+			if(position < m_size && m_keys[position] == d)
+				return false;
+			if(m_size < N)
+			{
+				copy_backward(m_keys + position, m_keys + m_size,
+					m_keys + m_size + 1);
+				m_keys[position] = d;
+				m_size++;
+				return true;
+			}
+			promote();
+		}
+		if(!m_tree->insert(d))
+			return false;
+		m_size++;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// inserts a batch of elements
+	// returns the number of elements actually inserted
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	template <class InputIt>
+	int smallAvl<T, N>::bulkInsert(InputIt first, InputIt last)
+	{
+		int count = 0;
+		if(m_tree == nullptr)
+		{
+			for(; first != last; ++first)
+			{
+				if(insert(*first))
+					count++;
+				if(m_tree != nullptr)
+				{
+					++first;
+					break;
+				}
+			}
+			if(m_tree == nullptr)
+				return count;
+		}
+		int added = m_tree->bulkInsert(first, last);
+		m_size += static_cast<size_t>(added);
+		return count + added;
+	}
+
+	//--------------------------------------------------------------------
+	// removes d, returning to the array once the tree is half empty
+	// returns true if d was found and removed
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	bool smallAvl<T, N>::erase(const T& d)
+	{
+		if(m_tree != nullptr)
+		{
+			if(!m_tree->erase(d))
+				return false;
+			if(--m_size <= N / 2)
+				demote();
+			return true;
+		}
+		size_t position = lowerBound(d);
+		if(position == m_size || !(m_keys[position] == d))
+			return false;
+		copy(m_keys + position + 1, m_keys + m_size, m_keys + position);
+		m_size--;
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// returns the smallest key
+	// throws invalid_argument if the set is empty
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	typename smallAvl<T, N>::valueType smallAvl<T, N>::min() const
+	{
+		if(m_size == 0)
+			throw (invalid_argument("Tree is empty"));
+		return m_tree ? m_tree->min() : m_keys[0];
+	}
+
+	//--------------------------------------------------------------------
+	// returns the largest key
+	// throws invalid_argument if the set is empty
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	typename smallAvl<T, N>::valueType smallAvl<T, N>::max() const
+	{
+		if(m_size == 0)
+			throw (invalid_argument("Tree is empty"));
+		return m_tree ? m_tree->max() : m_keys[m_size - 1];
+	}
+
+	//--------------------------------------------------------------------
+	// removes & returns the smallest (or, if high, the largest) key,
+	// returning to the array once the tree is half empty
+	// throws invalid_argument if the set is empty
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	T smallAvl<T, N>::popEnd(bool high)
+	{
+		if(m_size == 0)
+			throw (invalid_argument("Tree is empty"));
+		if(m_tree != nullptr)
+		{
+			T d = high ? m_tree->popMax() : m_tree->popMin();
+			if(--m_size <= N / 2)
+				demote();
+			return d;
+		}
+		m_size--;
+		if(high)
+			return m_keys[m_size];
+		T d = m_keys[0];
+		copy(m_keys + 1, m_keys + m_size + 1, m_keys);
+		return d;
+	}
+
+	//--------------------------------------------------------------------
+	// moves the inline keys into a new tree
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	void smallAvl<T, N>::promote()
+	{
+		avl<T>* tree = new avl<T>;
+		try
+		{
+			tree->bulkInsert(m_keys, m_keys + m_size);
+		}
+		catch(bad_alloc&)
+		{
+			delete tree;
+			throw;
+		}
+		m_tree = tree;
+	}
+
+	//--------------------------------------------------------------------
+	// moves the tree's keys back into the array and frees the tree
+	// pre: the tree holds no more than N keys
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	void smallAvl<T, N>::demote()
+	{
+		size_t count = 0;
+		vector<const node<T>*> pending;
+		const node<T>* cur = m_tree->getroot();
+		while(cur != nullptr || !pending.empty())
+		{
+			for(; cur != nullptr; cur = cur->left)
+				pending.push_back(cur);
+			cur = pending.back();
+			pending.pop_back();
+			m_keys[count++] = cur->value();
+			cur = cur->right;
+		}
+		delete m_tree;
+		m_tree = nullptr;
+		m_size = count;
+	}
+
+	//--------------------------------------------------------------------
+	// prints out the keys inorder as "value ", inline or not; inline
+	// keys have no height, so the tree's heights are left out too
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	void smallAvl<T, N>::print(ostream& out) const
+	{
+		streamWriter w(out);
+		for(iterator it = begin(); it != end(); ++it)
+		{
+			writeValue(w, *it);
+			w.put(' ');
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for smallAvl<T, N>
+	//--------------------------------------------------------------------
+	template <class T, size_t N>
+	ostream& operator<<(ostream& out, const smallAvl<T, N>& s)
+	{
+		s.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif
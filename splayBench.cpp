@@ -0,0 +1,193 @@
+//----------------------------------------------------------------------------
+// File:		splayBench.cpp
+//
+// Description: Benchmark of splayTree<T> against avl<T> on lookups whose
+//				keys follow a Zipf distribution of skew s = 0 to 2, on runs
+//				of one repeated key and on a sequential scan
+//
+// Programmer:  Anthony Waddell
+//
+// Functions:   main()
+//				zipfQueries()
+//				timeLookups()
+//				compare()
+//
+// Environment: Hardware: PC, i7
+//              Software: OS: Windows 10
+//              Compiles under Microsoft Visual C++ 2015; not part of the
+//				driver project, build it as its own console program
+//-------------------------------------------------------------------------
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "splayTree.h"
+#include "benchMix.h"
+using namespace std;
+
+namespace
+{
+	//---------------------------------------------------------------------------
+	// Function:	zipfQueries()
+	// Title:		Zipf distributed lookup keys
+	// Description: Draws count keys from ranked, where the key of rank i
+	//				(from 1) is drawn with probability proportional to
+	//				1 / i^skew.  A skew of 0 is uniform.  Draws invert the
+	//				cumulative weights with a binary search.
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		n/a
+	// Called By:	main()
+	// Parameters:	const vector<int>& ranked; keys, most popular first
+	//				double skew; s, 0 or more
+	//				int count; keys to draw
+	//				mt19937& rng; random source
+	// Returns:		the drawn keys
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	vector<int> zipfQueries(const vector<int>& ranked, double skew,
+		int count, mt19937& rng)
+	{
+		vector<double> cumulative(ranked.size());
+		double total = 0;
+		for(size_t i = 0; i < ranked.size(); i++)
+		{
+			total += 1.0 / pow(static_cast<double>(i + 1), skew);
+			cumulative[i] = total;
+		}
+		uniform_real_distribution<double> pick(0, total);
+		vector<int> queries(count);
+		for(int i = 0; i < count; i++)
+		{
+			size_t rank = lower_bound(cumulative.begin(), cumulative.end(),
+				pick(rng)) - cumulative.begin();
+			queries[i] = ranked[min(rank, ranked.size() - 1)];
+		}
+		return queries;
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	timeLookups()
+	// Title:		Times a run of lookups
+	// Description: Calls find() for every query; a splayTree splays each
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		tree.find()
+	// Called By:	compare()
+	// Parameters:	Tree& tree; tree to search
+	//				const vector<int>& queries; keys to find
+	// Returns:		seconds taken
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	template <class Tree>
+	double timeLookups(Tree& tree, const vector<int>& queries)
+	{
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		long hits = 0;
+		for(size_t i = 0; i < queries.size(); i++)
+			hits += (tree.find(queries[i]) != nullptr);
+		AW_BST::keepResult(hits);
+		return AW_BST::secondsSince(start);
+	}
+
+	//---------------------------------------------------------------------------
+	// Function:	compare()
+	// Title:		Times one query stream on both trees
+	// Description: Builds a balanced avl<int> and a balanced splayTree<int>
+	//				from keys, runs queries on each and prints one row
+	//
+	// Programmer:	Anthony Waddell
+	// Date:		10-19-26
+	// Version:		1.0
+	//
+	// Calls:		avl<int>::bulkInsert(), splayTree<int>::bulkInsert(),
+	//				timeLookups()
+	// Called By:	main()
+	// Parameters:	const string& label; name of the query stream
+	//				const vector<int>& keys; keys to store, sorted
+	//				const vector<int>& queries; keys to find
+	// Returns:		void
+	// History Log: 10-19-26 AW Completed v 1.0
+	//---------------------------------------------------------------------------
+	void compare(const string& label, const vector<int>& keys,
+		const vector<int>& queries)
+	{
+		AW_BST::avl<int> balanced;
+		balanced.bulkInsert(keys.begin(), keys.end());
+		AW_BST::splayTree<int> splay;
+		splay.bulkInsert(keys.begin(), keys.end());
+		double avlTime = timeLookups(balanced, queries);
+		double splayTime = timeLookups(splay, queries);
+		cout << "  " << left << setw(22) << label << right
+			<< "avl " << setw(6) << avlTime << "s  splay "
+			<< setw(6) << splayTime << "s" << endl;
+	}
+}
+
+//---------------------------------------------------------------------------
+// Function:	main()
+// Title:		splayTree benchmark
+// Description: Stores n keys, ranks them in a random order of popularity
+//				and compares avl<int> with splayTree<int> on Zipf
+//				lookups for s = 0, 0.5, 1, 1.2, 1.5 and 2, on runs of 64
+//				repeats of one key, and on a sequential scan.  Both trees
+//				start balanced.
+//
+// Programmer:	Anthony Waddell
+// Date:		10-19-26
+// Version:		1.0
+//
+// Input:		optional arguments: keys (default 1000000) and lookups
+//				(default 4000000)
+// Output:		seconds for each tree, one row per query stream
+// Calls:		zipfQueries(), compare()
+// Called By:	n/a
+// Parameters:  int argc, char* argv[]
+// Returns:		EXIT_SUCCESS
+// History Log:	10-19-26 AW Completed v 1.0
+//---------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+	int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+	int lookups = (argc > 2) ? atoi(argv[2]) : 4000000;
+	const int RUN = 64;
+	const double SKEWS[] = {0.0, 0.5, 1.0, 1.2, 1.5, 2.0};
+	mt19937 rng(3);
+
+	vector<int> keys(n);
+	for(int i = 0; i < n; i++)
+		keys[i] = i * 7;
+	vector<int> ranked(keys);
+	shuffle(ranked.begin(), ranked.end(), rng);
+
+	cout << n << " keys, " << lookups << " lookups" << endl;
+	cout << fixed << setprecision(2);
+	for(size_t s = 0; s < sizeof(SKEWS) / sizeof(SKEWS[0]); s++)
+	{
+		ostringstream label;
+		label << "zipf s=" << setprecision(1) << fixed << SKEWS[s];
+		compare(label.str(), keys, zipfQueries(ranked, SKEWS[s], lookups, rng));
+	}
+
+	vector<int> runs;
+	while(static_cast<int>(runs.size()) + RUN <= lookups)
+		runs.insert(runs.end(), RUN, ranked[rng() % n]);
+	compare("runs of 64 repeats", keys, runs);
+
+	vector<int> scan;
+	while(static_cast<int>(scan.size()) + n <= lookups)
+		scan.insert(scan.end(), keys.begin(), keys.end());
+	compare("sequential scan", keys, scan);
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,405 @@
+#ifndef SPLAYTREE_H
+#define SPLAYTREE_H
+//--------------------------------------------------------------------
+// A self-adjusting splay tree built on avl<T>'s rotations
+//--------------------------------------------------------------------
+#include <limits>
+#include "avl.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// a balancing policy whose slack no height difference can exceed, so
+	// avl<T, noBalance> never rotates on its own
+	//--------------------------------------------------------------------
+	typedef heightBalance<numeric_limits<int>::max()> noBalance;
+
+	//--------------------------------------------------------------------
+	// Splay Tree
+	// Class:		splayTree<T>: public avl<T, noBalance>
+	//				REQUIRES Type T be able convert from int & have
+	//				< & == defined
+	//
+	// File:		splayTree.h
+	// Title:		splayTree template Class; inherits from avl<T>
+	// Description: A binary search tree that moves every key it finds,
+	//				inserts or erases to the root with avl<T>'s single and
+	//				double rotations (zig, zig-zig and zig-zag steps), so
+	//				keys looked up often stay within a few levels of the
+	//				root.  Any sequence of operations costs O(log n)
+	//				amortized each, but one operation may walk O(n)
+	//				levels, so it suits skewed lookups rather than
+	//				latency-bound ones.  Non-const find() and contains()
+	//				splay; through a const reference they only search.
+	//				Splaying moves nodes, so it invalidates iterators.
+	//				Copies are built balanced.  A splay tree can be a
+	//				path of n nodes, so nothing here recurses on its
+	//				height: the set operations first relink both trees
+	//				balanced, O(n + m) more, and avl<T>'s recursive pops
+	//				and lazy erase are not available.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class splayTree<T>:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			splayTree(bool multiset = false) -- default constructor
+	//			splayTree(const splayTree<T>& t) -- balanced deep copy
+	//			node<T>* find(const T& d) -- finds d and splays it to the
+	//				root
+	//			bool contains(const T& d) -- true if d is present; splays
+	//			splayTree<T>& operator+=(const T d) -- adds an element
+	//
+	//     non-inline:
+	//			splayTree<T>& operator=(const splayTree<T>& t)
+	//				-- balanced deep copy
+	//			bool insert(T d) -- adds d as the new root
+	//			bool erase(const T& d) -- removes d, joining its subtrees
+	//			int bulkInsert(InputIt first, InputIt last)
+	//				-- adds a batch, splaying each key
+	//			splayTree<T>& unionWith(avl<T, noBalance>& t)
+	//			splayTree<T>& intersectWith(avl<T, noBalance>& t)
+	//			splayTree<T>& subtract(avl<T, noBalance>& t)
+	//			void splitAt(const T& d, avl<T, noBalance>& upper)
+	//			splayTree<T>& append(avl<T, noBalance>& t)
+	//				-- avl<T>'s versions, on trees relinked balanced
+	//		protected:
+	//			node<T>* splay(const T& d) -- moves d, or the last node
+	//				on its search path, to the root
+	//			void copyBalanced(const splayTree<T>& t)
+	//				-- builds a balanced copy of t's nodes
+	//			static void straighten(node<T>*& np)
+	//				-- relinks a subtree's nodes height-balanced
+	//			static node<T>* linkBalanced(node<T>** first,
+	//				node<T>** last) -- links sorted nodes balanced
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	template <class T>
+	class splayTree : public avl<T, noBalance>
+	{
+	public:
+		using bst<T>::find;
+		using bst<T>::contains;
+
+		explicit splayTree(bool multiset = false)
+			: avl<T, noBalance>(multiset) {}
+		splayTree(const splayTree<T>& t) : avl<T, noBalance>(t.m_multiset)
+			{copyBalanced(t);}
+		splayTree<T>& operator=(const splayTree<T>& t);
+
+		node<T>* find(const T& d)
+		{
+			node<T>* np = splay(d);
+			return (np != nullptr && d == np->value()) ? np : nullptr;
+		}
+		bool contains(const T& d) {return find(d) != nullptr;}
+		bool insert(T d);
+		bool erase(const T& d);
+		splayTree<T>& operator+=(const T d) {insert(d); return *this;}
+		template <class InputIt>
+		int bulkInsert(InputIt first, InputIt last);
+		splayTree<T>& unionWith(avl<T, noBalance>& t)
+			{straighten(root); straighten(t.getroot());
+			avl<T, noBalance>::unionWith(t); return *this;}
+		splayTree<T>& intersectWith(avl<T, noBalance>& t)
+			{straighten(root); straighten(t.getroot());
+			avl<T, noBalance>::intersectWith(t); return *this;}
+		splayTree<T>& subtract(avl<T, noBalance>& t)
+			{straighten(root); straighten(t.getroot());
+			avl<T, noBalance>::subtract(t); return *this;}
+		void splitAt(const T& d, avl<T, noBalance>& upper)
+			{straighten(root); avl<T, noBalance>::splitAt(d, upper);}
+		splayTree<T>& append(avl<T, noBalance>& t)
+			{straighten(root); straighten(t.getroot());
+			avl<T, noBalance>::append(t); return *this;}
+
+	protected:
+		using avl<T, noBalance>::root;
+		using avl<T, noBalance>::m_multiset;
+		using avl<T, noBalance>::reserveRoom;
+		using avl<T, noBalance>::noteChurn;
+		using avl<T, noBalance>::rotateRight;
+		using avl<T, noBalance>::rotateLeft;
+		using avl<T, noBalance>::rotateRightLeft;
+		using avl<T, noBalance>::rotateLeftRight;
+
+		node<T>* splay(const T& d);
+		void copyBalanced(const splayTree<T>& t);
+		static void straighten(node<T>*& np);
+		static node<T>* linkBalanced(node<T>** first, node<T>** last);
+
+		vector<node<T>*> m_path;   // reused by splay()
+
+	private:   // these recurse once per level of a tree of any shape
+		using avl<T, noBalance>::popNode;
+		using avl<T, noBalance>::popLow;
+		using avl<T, noBalance>::popHigh;
+		using avl<T, noBalance>::popnode;
+		using avl<T, noBalance>::poplow;
+		using avl<T, noBalance>::popfirst;
+		using avl<T, noBalance>::popFirstOf;
+		using avl<T, noBalance>::setHeight;
+		using avl<T, noBalance>::setLazyErase;
+	};
+
+	//--------------------------------------------------------------------
+	// overloaded =; the copy is balanced whatever shape t is in
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	splayTree<T>& splayTree<T>::operator=(const splayTree<T>& t)
+	{
+		if(this != &t)
+		{
+			this->delTree(root);
+			m_multiset = t.m_multiset;
+			copyBalanced(t);
+		}
+		return *this;
+	}
+
+	//--------------------------------------------------------------------
+	// walks down to d, or to the node where d's search falls off the
+	// tree, then rotates that node up to the root two levels at a time.
+	// A node in line with its parent and grandparent lifts the parent
+	// first (zig-zig); one that is not lifts itself twice (zig-zag).
+	// Each rotation refreshes the heights of the nodes it moves, so the
+	// whole path is correct once the node reaches the root.
+	// returns the new root, nullptr for an empty tree
+	//--------------------------------------------------------------------
+	template <class T>
+	node<T>* splayTree<T>::splay(const T& d)
+	{
+		m_path.clear();
+		for(node<T>* cur = root; cur != nullptr;
+			cur = cur->child(cur->value() < d))
+		{
+			m_path.push_back(cur);
+			if(d == cur->value())
+				break;
+		}
+		size_t i = m_path.size();
+		if(i == 0)
+			return nullptr;
+		for(i--; i > 0; )
+		{
+			node<T>* x = m_path[i];
+			node<T>* parent = m_path[i - 1];
+			bool xLeft = (parent->left == x);
+			if(i == 1)
+			{   // zig
+				root = xLeft ? rotateRight(parent) : rotateLeft(parent);
+				break;
+			}
+			node<T>* grand = m_path[i - 2];
+			bool parentLeft = (grand->left == parent);
+			node<T>* lifted;
+			if(xLeft == parentLeft)   // zig-zig
+				lifted = xLeft ? rotateRight(rotateRight(grand))
+					: rotateLeft(rotateLeft(grand));
+			else                      // zig-zag
+				lifted = parentLeft ? rotateLeftRight(grand)
+					: rotateRightLeft(grand);
+			i -= 2;
+			m_path[i] = lifted;    // x now sits where grand was
+			if(i == 0)
+				root = lifted;
+			else
+			{
+				node<T>* above = m_path[i - 1];
+				(above->left == grand ? above->left : above->right) = lifted;
+			}
+		}
+		return root;
+	}
+
+	//--------------------------------------------------------------------
+	// adds d; after splaying, the root is d's neighbour, so d becomes the
+	// new root with the old root on one side.  A multiset counts a
+	// duplicate instead.
+	// returns false for a duplicate in a set
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class T>
+	bool splayTree<T>::insert(T d)
+	{
+		reserveRoom(1);
+		if(splay(d) == nullptr)
+		{
+			root = new node<T>(d);
+			this->trackNew(root);
+		}
+		else if(d == root->value())
+		{
+			if(!m_multiset)
+				return false;
+			root->setCount(root->getCount() + 1);
+			root->update();
+		}
+		else
+		{
+			node<T>* np = new node<T>(d);
+			if(d < root->value())
+			{
+				np->left = root->left;
+				root->left = nullptr;
+				np->right = root;
+			}
+			else
+			{
+				np->right = root->right;
+				root->right = nullptr;
+				np->left = root;
+			}
+			root->update();
+			np->update();
+			root = np;
+			this->trackNew(np);
+		}
+		noteChurn();
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// removes one copy of d; with d splayed to the root, splaying d
+	// again in the left subtree lifts its largest node, which has no
+	// right child to lose, and the right subtree hangs off it
+	// returns false if d is not present
+	//--------------------------------------------------------------------
+	template <class T>
+	bool splayTree<T>::erase(const T& d)
+	{
+		if(splay(d) == nullptr || !(d == root->value()))
+			return false;
+		if(m_multiset && root->getCount() > 1)
+		{
+			root->setCount(root->getCount() - 1);
+			root->update();
+		}
+		else
+		{
+			node<T>* doomed = root;
+			node<T>* right = root->right;
+			root = root->left;
+			if(root == nullptr)
+				root = right;
+			else
+			{
+				splay(d);
+				root->right = right;
+				root->update();
+			}
+			this->trackGone(doomed);
+			delete doomed;
+		}
+		noteChurn();
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// adds a batch: an empty tree is built balanced, as avl<T> does;
+	// otherwise each key is inserted, and so splayed, in sorted order
+	// returns the number of keys actually inserted
+	// throws bad_alloc, length_error
+	//--------------------------------------------------------------------
+	template <class T>
+	template <class InputIt>
+	int splayTree<T>::bulkInsert(InputIt first, InputIt last)
+	{
+		if(this->isempty())
+			return avl<T, noBalance>::bulkInsert(first, last);
+		vector<T> batch(first, last);
+		sort(batch.begin(), batch.end());
+		int count = 0;
+		for(size_t i = 0; i < batch.size(); i++)
+		{
+			if(insert(batch[i]))
+				count++;
+		}
+		return count;
+	}
+
+	//--------------------------------------------------------------------
+	// relinks the nodes below and including np into a height-balanced
+	// subtree, in place; walked without recursion however deep it is
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void splayTree<T>::straighten(node<T>*& np)
+	{
+		vector<node<T>*> nodes;
+		vector<node<T>*> pending;
+		node<T>* cur = np;
+		while(cur != nullptr || !pending.empty())
+		{
+			for(; cur != nullptr; cur = cur->left)
+				pending.push_back(cur);
+			cur = pending.back();
+			pending.pop_back();
+			nodes.push_back(cur);
+			cur = cur->right;
+		}
+		np = linkBalanced(nodes.data(), nodes.data() + nodes.size());
+	}
+
+	//--------------------------------------------------------------------
+	// links sorted nodes into a balanced subtree, the middle one at the
+	// root of each subtree; recursion depth is O(log n)
+	//--------------------------------------------------------------------
+	template <class T>
+	node<T>* splayTree<T>::linkBalanced(node<T>** first, node<T>** last)
+	{
+		if(first == last)
+			return nullptr;
+		node<T>** middle = first + (last - first) / 2;
+		(*middle)->left = linkBalanced(first, middle);
+		(*middle)->right = linkBalanced(middle + 1, last);
+		(*middle)->update();
+		return *middle;
+	}
+
+	//--------------------------------------------------------------------
+	// builds a height-balanced copy of t's nodes in place of this tree's
+	// empty one; t is walked without recursion, however deep it is
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	template <class T>
+	void splayTree<T>::copyBalanced(const splayTree<T>& t)
+	{
+		vector<T> keys;
+		vector<size_t> counts;
+		keys.reserve(t.size());
+		counts.reserve(t.size());
+		vector<const node<T>*> pending;
+		const node<T>* cur = t.root;
+		while(cur != nullptr || !pending.empty())
+		{
+			for(; cur != nullptr; cur = cur->left)
+				pending.push_back(cur);
+			cur = pending.back();
+			pending.pop_back();
+			keys.push_back(cur->value());
+			counts.push_back(cur->getCount());
+			cur = cur->right;
+		}
+		if(!keys.empty())
+			root = this->buildBalanced(keys.data(),
+				keys.data() + keys.size(), counts.data());
+		this->findEnds();
+	}
+
+} // end namespace AW_BST
+
+#endif
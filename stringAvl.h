@@ -0,0 +1,593 @@
+#ifndef STRINGAVL_H
+#define STRINGAVL_H
+//--------------------------------------------------------------------
+// An avl set of strings stored in a byte arena, with prefix scans
+//--------------------------------------------------------------------
+#include <cstring>
+#include <memory>
+#include "bst.h"
+using namespace std;
+
+namespace AW_BST
+{
+	//--------------------------------------------------------------------
+	// String AVL Tree
+	// Class:		stringAvl
+	//
+	// File:		stringAvl.h
+	// Title:		stringAvl Class
+	// Description: An avl set of byte strings, ordered as std::string
+	//				orders them.  A node is 40 bytes: keys of up to 16
+	//				bytes live inside it, longer ones in a shared arena of
+	//				64K chunks with no per-key allocation.  Erased keys
+	//				leave their bytes in the arena until the garbage
+	//				passes half of it, when the live keys are copied to a
+	//				fresh arena.
+	//
+	//				A descent remembers how many bytes the key shares with
+	//				the nearest ancestors it went left and right of.  Every
+	//				key in the current subtree lies between those two, so
+	//				it shares at least the smaller of the two prefixes
+	//				with the key too, and each comparison starts there.
+	//				Keys with long common prefixes (URLs, paths) are then
+	//				read about once per lookup instead of once per level.
+	//
+	//				node<T> holds its key by value, so this is a separate
+	//				class with the same printed format.
+	//
+	// Programmer:	Anthony Waddell
+	//
+	// Date:		October 2026
+	// Version:		1.0
+	//
+	// Environment: Hardware: PC, i7
+	//				Software: OS: Windows 10
+	//				Compiles under Microsoft Visual C++ 2015
+	//
+	// class stringAvl:
+	//
+	//   Methods:
+	//
+	//     inline:
+	//			stringAvl() -- default constructor
+	//			~stringAvl() -- destructor
+	//			bool insert(const string& key) -- adds key
+	//			bool erase(const string& key) -- removes key
+	//			bool contains(const string& key) const -- true if present
+	//			bool isempty() const -- true if the tree is empty
+	//			size_t size() const -- number of keys
+	//			int getHeight() const -- height of the tree
+	//			size_t memoryUsage() const -- bytes of nodes and arena
+	//			void prefixScan(const string& prefix, Visitor visit)
+	//				const -- visits the keys starting with prefix
+	//			void forEach(Visitor visit) const -- visits every key
+	//
+	//     non-inline:
+	//			bool insert(const char* key, size_t length)
+	//			bool erase(const char* key, size_t length)
+	//			bool contains(const char* key, size_t length) const
+	//			void clear() -- removes every key
+	//			void print(ostream& out) const -- prints the tree inorder
+	//		private:
+	//			static int compare(const char* key, size_t length,
+	//				const stringNode* np, size_t& matched)
+	//				-- orders key against np's, starting at matched
+	//			bool insert(stringNode*& np, ...) -- recursive insert
+	//			bool erase(stringNode*& np, ...) -- recursive erase
+	//			stringNode* detachMin(stringNode*& np)
+	//				-- unlinks the smallest node of a subtree
+	//			static void rebalance(stringNode*& np)
+	//			static stringNode* rotateRight(stringNode* np)
+	//			static stringNode* rotateLeft(stringNode* np)
+	//			stringNode* newNode(const char* key, size_t length)
+	//			void freeNode(stringNode* np)
+	//			const char* store(const char* key, size_t length)
+	//				-- copies a long key into the arena
+	//			void compactArena() -- drops the bytes of erased keys
+	//			void prefixScan(const stringNode* np, ...) const
+	//				-- recursive prefix scan
+	//
+	// History Log:
+	//					10-19-26 AW completed v 1.0
+	//-------------------------------------------------------------------
+	class stringAvl
+	{
+		struct stringNode;
+	public:
+		static const size_t INLINE_BYTES = 16;       // keys kept in the node
+		static const size_t CHUNK_BYTES = 64 << 10;  // arena growth step
+
+		stringAvl() : m_root(nullptr), m_size(0), m_next(nullptr),
+			m_chunkLeft(0), m_arenaBytes(0), m_garbage(0) {}
+		~stringAvl() {clear();}
+
+		bool insert(const string& key) {return insert(key.data(), key.size());}
+		bool insert(const char* key, size_t length);
+		bool erase(const string& key) {return erase(key.data(), key.size());}
+		bool erase(const char* key, size_t length);
+		bool contains(const string& key) const
+			{return contains(key.data(), key.size());}
+		bool contains(const char* key, size_t length) const;
+		bool isempty() const {return m_root == nullptr;}
+		size_t size() const {return m_size;}
+		int getHeight() const {return m_root ? m_root->height : 0;}
+		size_t memoryUsage() const
+			{return m_size * sizeof(stringNode) + m_arenaBytes;}
+		template <class Visitor>
+		void prefixScan(const string& prefix, Visitor visit) const
+		{
+			string key;
+			prefixScan(m_root, prefix.data(), prefix.size(), key, visit);
+		}
+		template <class Visitor>
+		void forEach(Visitor visit) const {prefixScan(string(), visit);}
+		void clear();
+		void print(ostream& out) const;
+
+	private:
+		struct stringNode
+		{
+			stringNode(uint32_t n) : left(nullptr), right(nullptr),
+				length(n), height(1) {}
+			const char* data() const
+				{return (length <= INLINE_BYTES) ? bytes : text;}
+			void update()
+			{
+				int lHeight = left ? left->height : 0;
+				int rHeight = right ? right->height : 0;
+				height = 1 + ((lHeight > rHeight) ? lHeight : rHeight);
+			}
+			int balance() const
+				{return (left ? left->height : 0) - (right ? right->height : 0);}
+
+			stringNode* left;
+			stringNode* right;
+			uint32_t length;
+			int height;
+			union
+			{
+				char bytes[INLINE_BYTES];
+				const char* text;     // in the arena
+			};
+		};
+
+		stringAvl(const stringAvl&);              // not copyable
+		stringAvl& operator=(const stringAvl&);
+
+		static int compare(const char* key, size_t length,
+			const stringNode* np, size_t& matched);
+		bool insert(stringNode*& np, const char* key, size_t length,
+			size_t low, size_t high);
+		bool erase(stringNode*& np, const char* key, size_t length,
+			size_t low, size_t high);
+		stringNode* detachMin(stringNode*& np);
+		static void rebalance(stringNode*& np);
+		static stringNode* rotateRight(stringNode* np);
+		static stringNode* rotateLeft(stringNode* np);
+		stringNode* newNode(const char* key, size_t length);
+		void freeNode(stringNode* np);
+		const char* store(const char* key, size_t length);
+		void compactArena();
+		template <class Visitor>
+		void prefixScan(const stringNode* np, const char* prefix,
+			size_t length, string& key, Visitor& visit) const;
+
+		stringNode* m_root;
+		size_t m_size;
+		vector<unique_ptr<char[]>> m_chunks;
+		char* m_next;          // free space in the newest chunk
+		size_t m_chunkLeft;
+		size_t m_arenaBytes;   // chunk bytes allocated
+		size_t m_garbage;      // arena bytes of erased keys
+	};
+
+	//--------------------------------------------------------------------
+	// orders key against np's key, as memcmp would with the shorter one
+	// first on a tie; the first matched bytes are known to be equal.
+	// matched receives the length of their common prefix.
+	// returns < 0, 0 or > 0 as key is below, equal to or above np's key
+	//--------------------------------------------------------------------
+	inline int stringAvl::compare(const char* key, size_t length,
+		const stringNode* np, size_t& matched)
+	{
+		const char* other = np->data();
+		size_t shorter = (length < np->length) ? length : np->length;
+		size_t i = matched;
+		while(i + 8 <= shorter && memcmp(key + i, other + i, 8) == 0)
+			i += 8;
+		while(i < shorter && key[i] == other[i])
+			i++;
+		matched = i;
+		if(i < shorter)
+			return (static_cast<unsigned char>(key[i])
+				< static_cast<unsigned char>(other[i])) ? -1 : 1;
+		return (length < np->length) ? -1 : (length > np->length) ? 1 : 0;
+	}
+
+	//--------------------------------------------------------------------
+	// adds key; false if it is already present
+	// throws length_error for a key of 4G bytes or more, bad_alloc
+	//--------------------------------------------------------------------
+	inline bool stringAvl::insert(const char* key, size_t length)
+	{
+		if(length > numeric_limits<uint32_t>::max())
+			throw (length_error("Key is too long"));
+		return insert(m_root, key, length, 0, 0);
+	}
+
+	//--------------------------------------------------------------------
+	// removes key; false if it is not present.  Compacts the arena once
+	// half of it is garbage; if that runs out of memory the garbage just
+	// stays until a later erase.
+	//--------------------------------------------------------------------
+	inline bool stringAvl::erase(const char* key, size_t length)
+	{
+		if(!erase(m_root, key, length, 0, 0))
+			return false;
+		if(m_garbage > CHUNK_BYTES && m_garbage > m_arenaBytes / 2)
+		{
+			try
+			{
+				compactArena();
+			}
+			catch(bad_alloc&)
+			{
+			}
+		}
+		return true;
+	}
+
+	//--------------------------------------------------------------------
+	// returns true if key is present
+	//--------------------------------------------------------------------
+	inline bool stringAvl::contains(const char* key, size_t length) const
+	{
+		size_t low = 0;     // bytes shared with the last node we went right of
+		size_t high = 0;    // ... and left of
+		for(const stringNode* np = m_root; np != nullptr; )
+		{
+			size_t matched = (low < high) ? low : high;
+			int order = compare(key, length, np, matched);
+			if(order == 0)
+				return true;
+			if(order < 0)
+			{
+				high = matched;
+				np = np->left;
+			}
+			else
+			{
+				low = matched;
+				np = np->right;
+			}
+		}
+		return false;
+	}
+
+	//--------------------------------------------------------------------
+	// inserts key below np; low and high are the bytes it shares with
+	// the bounding ancestors.  Rebalances on the way back up.
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline bool stringAvl::insert(stringNode*& np, const char* key,
+		size_t length, size_t low, size_t high)
+	{
+		if(np == nullptr)
+		{
+			np = newNode(key, length);
+			return true;
+		}
+		size_t matched = (low < high) ? low : high;
+		int order = compare(key, length, np, matched);
+		if(order == 0)
+			return false;
+		bool added = (order < 0)
+			? insert(np->left, key, length, low, matched)
+			: insert(np->right, key, length, matched, high);
+		if(added)
+		{
+			np->update();
+			rebalance(np);
+		}
+		return added;
+	}
+
+	//--------------------------------------------------------------------
+	// erases key below np.  A node with two children is replaced by its
+	// in-order successor, relinked rather than copied.
+	//--------------------------------------------------------------------
+	inline bool stringAvl::erase(stringNode*& np, const char* key,
+		size_t length, size_t low, size_t high)
+	{
+		if(np == nullptr)
+			return false;
+		size_t matched = (low < high) ? low : high;
+		int order = compare(key, length, np, matched);
+		if(order == 0)
+		{
+			stringNode* doomed = np;
+			if(np->left == nullptr || np->right == nullptr)
+				np = (np->left != nullptr) ? np->left : np->right;
+			else
+			{
+				stringNode* successor = detachMin(np->right);
+				successor->left = np->left;
+				successor->right = np->right;
+				np = successor;
+				np->update();
+				rebalance(np);
+			}
+			freeNode(doomed);
+			return true;
+		}
+		bool erased = (order < 0)
+			? erase(np->left, key, length, low, matched)
+			: erase(np->right, key, length, matched, high);
+		if(erased)
+		{
+			np->update();
+			rebalance(np);
+		}
+		return erased;
+	}
+
+	//--------------------------------------------------------------------
+	// unlinks and returns the leftmost node below np, rebalancing on the
+	// way back up
+	// pre: np is not empty
+	//--------------------------------------------------------------------
+	inline stringAvl::stringNode* stringAvl::detachMin(stringNode*& np)
+	{
+		if(np->left == nullptr)
+		{
+			stringNode* least = np;
+			np = np->right;
+			return least;
+		}
+		stringNode* least = detachMin(np->left);
+		np->update();
+		rebalance(np);
+		return least;
+	}
+
+	//--------------------------------------------------------------------
+	// restores the avl balance at np
+	//--------------------------------------------------------------------
+	inline void stringAvl::rebalance(stringNode*& np)
+	{
+		int balance = np->balance();
+		if(balance > 1)
+		{
+			if(np->left->balance() < 0)
+				np->left = rotateLeft(np->left);
+			np = rotateRight(np);
+		}
+		else if(balance < -1)
+		{
+			if(np->right->balance() > 0)
+				np->right = rotateRight(np->right);
+			np = rotateLeft(np);
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// lifts np's left child
+	//--------------------------------------------------------------------
+	inline stringAvl::stringNode* stringAvl::rotateRight(stringNode* np)
+	{
+		stringNode* temp = np->left;
+		np->left = temp->right;
+		temp->right = np;
+		np->update();
+		temp->update();
+		return temp;
+	}
+
+	//--------------------------------------------------------------------
+	// lifts np's right child
+	//--------------------------------------------------------------------
+	inline stringAvl::stringNode* stringAvl::rotateLeft(stringNode* np)
+	{
+		stringNode* temp = np->right;
+		np->right = temp->left;
+		temp->left = np;
+		np->update();
+		temp->update();
+		return temp;
+	}
+
+	//--------------------------------------------------------------------
+	// makes a leaf for key, inline if it fits
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline stringAvl::stringNode* stringAvl::newNode(const char* key,
+		size_t length)
+	{
+		stringNode* np = new stringNode(static_cast<uint32_t>(length));
+		if(length <= INLINE_BYTES)
+			memcpy(np->bytes, key, length);
+		else
+		{
+			try
+			{
+				np->text = store(key, length);
+			}
+			catch(...)
+			{
+				delete np;
+				throw;
+			}
+		}
+		m_size++;
+		return np;
+	}
+
+	//--------------------------------------------------------------------
+	// deletes an unlinked node; its arena bytes become garbage
+	//--------------------------------------------------------------------
+	inline void stringAvl::freeNode(stringNode* np)
+	{
+		if(np->length > INLINE_BYTES)
+			m_garbage += np->length;
+		delete np;
+		m_size--;
+	}
+
+	//--------------------------------------------------------------------
+	// copies a key into the arena, starting a new chunk when the current
+	// one is full; a key larger than a chunk gets a chunk of its own
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline const char* stringAvl::store(const char* key, size_t length)
+	{
+		if(length > m_chunkLeft)
+		{
+			size_t bytes = (length > CHUNK_BYTES) ? length : CHUNK_BYTES;
+			m_chunks.reserve(m_chunks.size() + 1);
+			m_chunks.push_back(unique_ptr<char[]>(new char[bytes]));
+			m_arenaBytes += bytes;
+			if(length == bytes)   // keep filling the previous chunk
+				return static_cast<const char*>(memcpy(
+					m_chunks.back().get(), key, length));
+			m_next = m_chunks.back().get();
+			m_chunkLeft = bytes;
+		}
+		char* at = m_next;
+		memcpy(at, key, length);
+		m_next += length;
+		m_chunkLeft -= length;
+		return at;
+	}
+
+	//--------------------------------------------------------------------
+	// copies every live long key into fresh chunks and frees the old
+	// ones, dropping the bytes of erased keys.  If memory runs out part
+	// way, both sets of chunks are kept and the tree stays valid.
+	// throws bad_alloc
+	//--------------------------------------------------------------------
+	inline void stringAvl::compactArena()
+	{
+		vector<unique_ptr<char[]>> old;
+		old.swap(m_chunks);
+		size_t oldBytes = m_arenaBytes;
+		m_next = nullptr;
+		m_chunkLeft = 0;
+		m_arenaBytes = 0;
+		try
+		{
+			vector<stringNode*> pending;
+			if(m_root != nullptr)
+				pending.push_back(m_root);
+			while(!pending.empty())
+			{
+				stringNode* np = pending.back();
+				pending.pop_back();
+				if(np->length > INLINE_BYTES)
+					np->text = store(np->text, np->length);
+				if(np->left != nullptr)
+					pending.push_back(np->left);
+				if(np->right != nullptr)
+					pending.push_back(np->right);
+			}
+		}
+		catch(...)
+		{
+			for(size_t i = 0; i < old.size(); i++)
+				m_chunks.push_back(move(old[i]));
+			m_arenaBytes += oldBytes;
+			throw;
+		}
+		m_garbage = 0;
+	}
+
+	//--------------------------------------------------------------------
+	// removes every key and frees the arena; iterative
+	//--------------------------------------------------------------------
+	inline void stringAvl::clear()
+	{
+		vector<stringNode*> pending;
+		if(m_root != nullptr)
+			pending.push_back(m_root);
+		while(!pending.empty())
+		{
+			stringNode* np = pending.back();
+			pending.pop_back();
+			if(np->left != nullptr)
+				pending.push_back(np->left);
+			if(np->right != nullptr)
+				pending.push_back(np->right);
+			delete np;
+		}
+		m_root = nullptr;
+		m_size = 0;
+		m_chunks.clear();
+		m_next = nullptr;
+		m_chunkLeft = 0;
+		m_arenaBytes = 0;
+		m_garbage = 0;
+	}
+
+	//--------------------------------------------------------------------
+	// calls visit(key) in order for each key below np that starts with
+	// prefix, skipping subtrees that lie wholly before or after them;
+	// recurses only to the left, so no deeper than the tree is high
+	//--------------------------------------------------------------------
+	template <class Visitor>
+	void stringAvl::prefixScan(const stringNode* np, const char* prefix,
+		size_t length, string& key, Visitor& visit) const
+	{
+		while(np != nullptr)
+		{
+			size_t shorter = (length < np->length) ? length : np->length;
+			int order = memcmp(np->data(), prefix, shorter);
+			if(order == 0 && np->length >= length)
+			{
+				prefixScan(np->left, prefix, length, key, visit);
+				key.assign(np->data(), np->length);
+				visit(static_cast<const string&>(key));
+				np = np->right;
+			}
+			else if(order <= 0)    // below every key with the prefix
+				np = np->right;
+			else
+				np = np->left;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// prints out the tree inorder, as "key(height) "
+	//--------------------------------------------------------------------
+	inline void stringAvl::print(ostream& out) const
+	{
+		streamWriter w(out);
+		vector<const stringNode*> pending;
+		const stringNode* cur = m_root;
+		while(cur != nullptr || !pending.empty())
+		{
+			for(; cur != nullptr; cur = cur->left)
+				pending.push_back(cur);
+			cur = pending.back();
+			pending.pop_back();
+			if(w.plain())
+				w.put(cur->data(), cur->length);
+			else
+				w.stream() << string(cur->data(), cur->length);
+			w.put('(');
+			writeValue(w, cur->height);
+			w.put(") ", 2);
+			cur = cur->right;
+		}
+	}
+
+	//--------------------------------------------------------------------
+	// Overloaded << for stringAvl
+	//--------------------------------------------------------------------
+	inline ostream& operator<<(ostream& out, const stringAvl& tree)
+	{
+		tree.print(out);
+		return out;
+	}
+
+} // end namespace AW_BST
+
+#endif